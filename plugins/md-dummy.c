@@ -16,6 +16,7 @@
 // Author: Julian Kunkel
 
 #include <stdio.h>
+#include <stdlib.h>
 #include <unistd.h>
 
 #include <plugins/md-dummy.h>
@@ -29,6 +30,16 @@ static int print_pattern = 0;
 static FILE * outfile = NULL;
 static int rank = -1;
 
+// the asynchronous interface executes the operation immediately and queues its result
+typedef struct{
+  void * tag;
+  int ret;
+} async_completion_t;
+
+static __thread async_completion_t * completions = NULL;
+static __thread int completions_count = 0;
+static __thread int completions_size = 0;
+
 static option_help options [] = {
   {'p', "print-pattern", "Prints the output pattern into pattern-<RANK>.txt", OPTION_FLAG, 'd', & print_pattern},
   {'f', "fake-errors", "Fake errors while running benchmark, best to use with --ignore-precreate-errors.", OPTION_FLAG, 'd', & fake_errors},
@@ -64,6 +75,20 @@ static int finalize(){
   if(outfile){
     fclose(outfile);
   }
+  free(completions);
+  completions = NULL;
+  completions_count = completions_size = 0;
+  return MD_SUCCESS;
+}
+
+static int thread_initialize(){
+  return MD_SUCCESS;
+}
+
+static int thread_finalize(){
+  free(completions);
+  completions = NULL;
+  completions_count = completions_size = 0;
   return MD_SUCCESS;
 }
 
@@ -77,13 +102,16 @@ static int purge_global(){
 }
 
 static int def_dset_name(char * out_name, int n, int d){
-  sprintf(out_name, "n=%d/d=%d", n, d);
+  char * pos = format_int(format_str(out_name, "n="), n);
+  format_int(format_str(pos, "/d="), d);
   return MD_SUCCESS;
 }
 
 
 static int def_obj_name(char * out_name, int n, int d, int i){
-  sprintf(out_name, "n=%d/d=%d/i=%d", n, d, i);
+  char * pos = format_int(format_str(out_name, "n="), n);
+  pos = format_int(format_str(pos, "/d="), d);
+  format_int(format_str(pos, "/i="), i);
   return MD_SUCCESS;
 }
 
@@ -151,7 +179,132 @@ static int delete_obj(char * dirname, char * filename){
   return MD_SUCCESS;
 }
 
+// the numeric interface defines the name only to print the pattern
+static int write_obj_id(int n, int d, int i, char * buf, size_t file_size){
+  char name[64] = "";
+  if(print_pattern){
+    def_obj_name(name, n, d, i);
+  }
+  return write_obj(NULL, name, buf, file_size);
+}
+
+static int read_obj_id(int n, int d, int i, char * buf, size_t file_size){
+  char name[64] = "";
+  if(print_pattern){
+    def_obj_name(name, n, d, i);
+  }
+  return read_obj(NULL, name, buf, file_size);
+}
+
+static int stat_obj_id(int n, int d, int i, size_t file_size){
+  char name[64] = "";
+  if(print_pattern){
+    def_obj_name(name, n, d, i);
+  }
+  return stat_obj(NULL, name, file_size);
+}
+
+static int delete_obj_id(int n, int d, int i){
+  char name[64] = "";
+  if(print_pattern){
+    def_obj_name(name, n, d, i);
+  }
+  return delete_obj(NULL, name);
+}
+
+static int queue_completion(void * tag, int ret){
+  if(completions_count == completions_size){
+    completions_size = completions_size == 0 ? 16 : completions_size * 2;
+    completions = realloc(completions, sizeof(async_completion_t) * completions_size);
+    if(completions == NULL){
+      return MD_ERROR_UNKNOWN;
+    }
+  }
+  completions[completions_count].tag = tag;
+  completions[completions_count].ret = ret;
+  completions_count++;
+  return MD_SUCCESS;
+}
+
+static int submit_write_obj(void * tag, char * dirname, char * filename, char * buf, size_t file_size){
+  return queue_completion(tag, write_obj(dirname, filename, buf, file_size));
+}
 
+static int submit_read_obj(void * tag, char * dirname, char * filename, char * buf, size_t file_size){
+  return queue_completion(tag, read_obj(dirname, filename, buf, file_size));
+}
+
+static int submit_stat_obj(void * tag, char * dirname, char * filename, size_t file_size){
+  return queue_completion(tag, stat_obj(dirname, filename, file_size));
+}
+
+static int submit_delete_obj(void * tag, char * dirname, char * filename){
+  return queue_completion(tag, delete_obj(dirname, filename));
+}
+
+static int poll_obj(void ** out_tag, int * out_ret){
+  if(completions_count == 0){
+    return MD_ERROR_FIND;
+  }
+  completions_count--;
+  *out_tag = completions[completions_count].tag;
+  *out_ret = completions[completions_count].ret;
+  return MD_SUCCESS;
+}
+
+static int write_objs(int count, char ** dsets, char ** names, char ** bufs, size_t file_size, int * out_ret){
+  for(int i=0; i < count; i++){
+    out_ret[i] = write_obj(dsets[i], names[i], bufs[i], file_size);
+  }
+  return MD_SUCCESS;
+}
+
+static int read_objs(int count, char ** dsets, char ** names, char ** bufs, size_t file_size, int * out_ret){
+  for(int i=0; i < count; i++){
+    out_ret[i] = read_obj(dsets[i], names[i], bufs[i], file_size);
+  }
+  return MD_SUCCESS;
+}
+
+static int stat_objs(int count, char ** dsets, char ** names, size_t file_size, int * out_ret){
+  for(int i=0; i < count; i++){
+    out_ret[i] = stat_obj(dsets[i], names[i], file_size);
+  }
+  return MD_SUCCESS;
+}
+
+static int delete_objs(int count, char ** dsets, char ** names, int * out_ret){
+  for(int i=0; i < count; i++){
+    out_ret[i] = delete_obj(dsets[i], names[i]);
+  }
+  return MD_SUCCESS;
+}
+
+static int bulk_create_objs(char * dirname, int n, int d, int first, int last, char * buf, size_t file_size, int * out_count){
+  char filename[4096];
+  *out_count = 0;
+  for(int i=first; i < last; i++){
+    def_obj_name(filename, n, d, i);
+    if(write_obj(dirname, filename, buf, file_size) != MD_SUCCESS){
+      return MD_ERROR_UNKNOWN;
+    }
+    (*out_count)++;
+  }
+  return MD_SUCCESS;
+}
+
+static int bulk_delete_objs(char * dirname, int n, int d, int first, int last, int * out_count){
+  char filename[4096];
+  *out_count = 0;
+  for(int i=first; i < last; i++){
+    def_obj_name(filename, n, d, i);
+    if(delete_obj(dirname, filename) != MD_SUCCESS){
+      return MD_ERROR_UNKNOWN;
+    }
+    (*out_count)++;
+  }
+  return MD_SUCCESS;
+}
 
 
 struct md_plugin md_plugin_dummy = {
@@ -170,5 +323,35 @@ struct md_plugin md_plugin_dummy = {
   write_obj,
   read_obj,
   stat_obj,
-  delete_obj
+  delete_obj,
+
+  write_obj_id,
+  read_obj_id,
+  stat_obj_id,
+  delete_obj_id,
+
+  submit_write_obj,
+  submit_read_obj,
+  submit_stat_obj,
+  submit_delete_obj,
+  poll_obj,
+
+  thread_initialize,
+  thread_finalize,
+
+  write_objs,
+  read_objs,
+  stat_objs,
+  delete_objs,
+
+  bulk_create_objs,
+  bulk_delete_objs,
+
+  NULL,
+
+  NULL,
+  NULL,
+
+  NULL,
+  NULL
 };
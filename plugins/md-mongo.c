@@ -19,6 +19,7 @@
 #include <mongoc.h>
 
 #include <plugins/md-mongo.h>
+#include <md_util.h>
 
 static char * database = "";
 static char * username = "";
@@ -27,9 +28,13 @@ static char * host = "localhost";
 static int port = 27017;
 
 static char * global_coll_name = "md_real_io";
-static mongoc_collection_t * global_collection = NULL; // global collection!
+static __thread mongoc_collection_t * global_collection = NULL; // global collection!
 static int collection_per_dir = 0;
 static int create_no_index = 0;
+static int name_index = 0;
+static char * write_concern = "default";
+static int journal = 0;
+static int unordered = 0;
 
 static option_help options [] = {
   {'D', "database", "Database name, this temporary database will be used for the test.", OPTION_REQUIRED_ARGUMENT, 's', & database},
@@ -38,6 +43,10 @@ static option_help options [] = {
   {'p', "port", "Port.", OPTION_OPTIONAL_ARGUMENT, 'd', & port},
   {'P', "password", "Passwort, if empty no password is assumed.", OPTION_OPTIONAL_ARGUMENT, 'H', & password},
   {'i', "no-index", "Create no index on the obj name.", OPTION_FLAG, 'd', & create_no_index},
+  {'n', "name-index", "Store the obj name in a separate field with a unique index instead of _id.", OPTION_FLAG, 'd', & name_index},
+  {'w', "write-concern", "The acknowledgement of writes: default, majority or the number of nodes, 0 means unacknowledged.", OPTION_OPTIONAL_ARGUMENT, 's', & write_concern},
+  {'j', "journal", "Writes are acknowledged once they are in the journal.", OPTION_FLAG, 'd', & journal},
+  {'u', "unordered", "Use unordered bulk operations, otherwise a bulk operation stops at the first error.", OPTION_FLAG, 'd', & unordered},
   {'c', "use-collection-per-dir", "Create one collection per directory, otherwise a global collection is used", OPTION_FLAG, 'd', & collection_per_dir},
   LAST_OPTION
 };
@@ -46,33 +55,77 @@ static option_help * get_options(){
   return options;
 }
 
-static mongoc_client_t * client;
-static mongoc_database_t * mongo_db;
+// a mongoc client must not be shared between threads, each thread connects on its own
+static __thread mongoc_client_t * client;
+static __thread mongoc_database_t * mongo_db;
+// $binarySize in the projection of a find needs MongoDB 4.4 (wire version 9), for older servers stat_obj fetches the data
+static __thread int stat_binary_size = 0;
+
+// the write concern is shared by all threads and used for all writes
+static mongoc_write_concern_t * wc = NULL;
+
+// the field that contains the obj name, _id is always indexed
+static const char * name_field(){
+  return (create_no_index || name_index) ? "obj" : "_id";
+}
+
+// the collection handles of the thread are kept until the collection is dropped
+static __thread cache_t collections;
+
+static mongoc_collection_t * get_collection(char * coll_name){
+  cache_entry_t * e = cache_find(& collections, coll_name);
+  if(e != NULL){
+    return (mongoc_collection_t *) e->value;
+  }
+  mongoc_collection_t * collection = mongoc_database_get_collection(mongo_db, coll_name);
+  cache_insert(& collections, coll_name, collection);
+  return collection;
+}
+
+static void destroy_collection(void * collection){
+  mongoc_collection_destroy((mongoc_collection_t *) collection);
+}
+
+static void release_collection(char * coll_name){
+  mongoc_collection_t * collection = cache_remove(& collections, coll_name);
+  if(collection != NULL){
+    destroy_collection(collection);
+  }
+}
+
+static void free_collections(){
+  cache_free(& collections, destroy_collection);
+}
 
 static int init_dir_internal(char * dir_name){
   // create a dummy collection and document to make sure the object can be created
   bson_t *doc;
   bson_error_t error;
-  mongoc_collection_t * collection = mongoc_database_get_collection(mongo_db, dir_name);
+  mongoc_collection_t * collection = get_collection(dir_name);
   doc = bson_new ();
   bson_append_utf8(doc, "_id", 3, "empty", 5);
+  if (name_index){
+    bson_append_utf8(doc, "obj", 3, "empty", 5);
+  }
 
   if (! mongoc_collection_insert (collection, MONGOC_INSERT_NONE, doc, NULL, &error)) {
+    printf("Error: %s\n", error.message);
+    bson_destroy (doc);
     return MD_ERROR_UNKNOWN;
   }
   bson_destroy (doc);
 
-  // create index by name
-  if (! create_no_index){
-    //doc = bson_new ();
-    //bson_append_int32(doc, "obj", 3, 1);
-    //ret = mongoc_collection_create_index (collection, doc, NULL, &error);
-    //bson_destroy (doc);
-    //if(! ret){
-    //  printf("Error: %s\n", error.message);
-    //}
-  }
-  mongoc_collection_destroy (collection);
+  // create a unique index by name, the name stored in _id is indexed by default
+  if (name_index && ! create_no_index){
+    bson_t * cmd = BCON_NEW("createIndexes", BCON_UTF8(dir_name),
+      "indexes", "[", "{", "key", "{", "obj", BCON_INT32(1), "}", "name", BCON_UTF8("obj_1"), "unique", BCON_BOOL(true), "}", "]");
+    int ret = mongoc_database_write_command_with_opts(mongo_db, cmd, NULL, NULL, & error);
+    bson_destroy (cmd);
+    if(! ret){
+      printf("Error: %s\n", error.message);
+      return MD_ERROR_UNKNOWN;
+    }
+  }
   return MD_SUCCESS;
 }
 
@@ -80,17 +133,16 @@ static int rm_dir_internal(char * dir_name){
   int ret;
   bson_t *doc;
   doc = bson_new ();
-  mongoc_collection_t * collection = mongoc_database_get_collection(mongo_db, dir_name);
+  mongoc_collection_t * collection = get_collection(dir_name);
   mongoc_collection_remove(collection, MONGOC_REMOVE_NONE, doc, NULL, NULL );
   bson_destroy (doc);
 
   ret = mongoc_collection_drop(collection, NULL);
-  mongoc_collection_destroy (collection);
+  release_collection(dir_name);
   return ret ? MD_SUCCESS : MD_ERROR_UNKNOWN;
 }
 
-static int initialize(){
-  mongoc_init ();
+static int thread_initialize(){
   char * conn_str = (char*) malloc(4096);
   char * current_pos = conn_str;
 
@@ -130,38 +182,79 @@ static int initialize(){
     return MD_ERROR_UNKNOWN;
   }
 
+  bson_t * cmd = BCON_NEW("isMaster", BCON_INT32(1));
+  bson_t reply;
+  bson_error_t error;
+  bson_iter_t iter;
+  if(mongoc_client_command_simple(client, "admin", cmd, NULL, & reply, & error)){
+    stat_binary_size = bson_iter_init_find(& iter, & reply, "maxWireVersion") && bson_iter_as_int64(& iter) >= 9;
+  }
+  bson_destroy(& reply);
+  bson_destroy(cmd);
+
   if(! collection_per_dir){
-    global_collection = mongoc_database_get_collection(mongo_db, global_coll_name);
+    global_collection = get_collection(global_coll_name);
   }
   return MD_SUCCESS;
 }
 
-static int finalize(){
+static int thread_finalize(){
+  free_collections();
+  global_collection = NULL;
+
   mongoc_database_destroy(mongo_db);
   mongoc_client_destroy (client);
-  mongoc_cleanup ();
+  return MD_SUCCESS;
+}
 
-  if(! collection_per_dir){
-    mongoc_collection_destroy (global_collection);
+static int initialize(){
+  mongoc_init ();
+  wc = mongoc_write_concern_new();
+  if (strcmp(write_concern, "majority") == 0){
+    mongoc_write_concern_set_w(wc, MONGOC_WRITE_CONCERN_W_MAJORITY);
+  }else if (strcmp(write_concern, "default") != 0){
+    char * end;
+    long w = strtol(write_concern, & end, 10);
+    if (*end != 0 || w < 0){
+      printf("Invalid write concern: %s\n", write_concern);
+      return MD_ERROR_UNKNOWN;
+    }
+    mongoc_write_concern_set_w(wc, (int32_t) w);
+  }
+  if (journal){
+    if (strcmp(write_concern, "0") == 0){
+      printf("Unacknowledged writes cannot be journaled\n");
+      return MD_ERROR_UNKNOWN;
+    }
+    mongoc_write_concern_set_journal(wc, true);
   }
+  return thread_initialize();
+}
 
+static int finalize(){
+  thread_finalize();
+  mongoc_write_concern_destroy(wc);
+  wc = NULL;
+  mongoc_cleanup ();
   return MD_SUCCESS;
 }
 
 static int def_dset_name(char * out_name, int n, int d){
+  char * pos = format_str(out_name, global_coll_name);
   if(collection_per_dir){
-    sprintf(out_name, "%s_%d_%d", global_coll_name, n, d);
-  }else{
-    sprintf(out_name, "%s", global_coll_name);
+    pos = format_int(format_str(pos, "_"), n);
+    format_int(format_str(pos, "_"), d);
   }
   return MD_SUCCESS;
 }
 
 static int def_obj_name(char * out_name, int n, int d, int i){
   if(collection_per_dir){
-    sprintf(out_name, "%d", i);
+    format_int(out_name, i);
   }else{
-    sprintf(out_name, "%d_%d_%d", n, d, i);
+    char * pos = format_int(out_name, n);
+    pos = format_int(format_str(pos, "_"), d);
+    format_int(format_str(pos, "_"), i);
   }
   return MD_SUCCESS;
 }
@@ -169,9 +262,7 @@ static int def_obj_name(char * out_name, int n, int d, int i){
 
 static int prepare_global(){
   if(! collection_per_dir){
-    int ret = init_dir_internal(global_coll_name);
-    global_collection = mongoc_database_get_collection(mongo_db, global_coll_name);
-    return ret;
+    return init_dir_internal(global_coll_name);
   }
   // make sure we can actually write to the database
   return init_dir_internal("dummy");
@@ -201,7 +292,7 @@ static int rm_dset(char * obj_name){
 
 static void construct_access(char * collname, char * obj_name, mongoc_collection_t ** out_collection, bson_t ** out_doc){
   if(collection_per_dir){
-    *out_collection = mongoc_database_get_collection(mongo_db, collname);
+    *out_collection = get_collection(collname);
   }else{
     *out_collection = global_collection;
   }
@@ -211,19 +302,12 @@ static void construct_access(char * collname, char * obj_name, mongoc_collection
   //bson_oid_t oid;
   //bson_oid_init (&oid, NULL);
   //BSON_APPEND_OID(doc, "_id", &oid);
-  if(create_no_index){
-    bson_append_utf8(doc, "obj", 3, obj_name, strlen(obj_name));
-  }else{
-    bson_append_utf8(doc, "_id", 3, obj_name, strlen(obj_name));
-  }
+  bson_append_utf8(doc, name_field(), -1, obj_name, strlen(obj_name));
 
   *out_doc = doc;
 }
 
 static void free_access(mongoc_collection_t * collection, bson_t * doc){
-  if(collection_per_dir){
-    mongoc_collection_destroy (collection);
-  }
   bson_destroy (doc);
 }
 
@@ -237,7 +321,7 @@ static int write_obj(char * collname, char * obj_name, char * buf, size_t obj_si
   if (! bson_append_binary (doc, "data", 4, BSON_SUBTYPE_BINARY, (const uint8_t*) buf, obj_size)){
     ret = MD_ERROR_UNKNOWN;
   }
-  if (ret == MD_SUCCESS && ! mongoc_collection_insert (collection, MONGOC_INSERT_NONE, doc, NULL, &error)) {
+  if (ret == MD_SUCCESS && ! mongoc_collection_insert (collection, MONGOC_INSERT_NONE, doc, wc, &error)) {
       ret = MD_ERROR_UNKNOWN;
   }
   free_access(collection, doc);
@@ -252,7 +336,9 @@ static int read_obj(char * collname, char * obj_name, char * buf, size_t obj_siz
   mongoc_collection_t * collection;
   construct_access(collname, obj_name, & collection, & doc);
 
-  mongoc_cursor_t * cursor = mongoc_collection_find_with_opts(collection, doc, NULL, NULL);
+  bson_t * opts = BCON_NEW("limit", BCON_INT64(1));
+  mongoc_cursor_t * cursor = mongoc_collection_find_with_opts(collection, doc, opts, NULL);
+  bson_destroy (opts);
 
   const bson_t *element;
   if(mongoc_cursor_next (cursor, &element)) {
@@ -285,14 +371,34 @@ static int stat_obj(char * collname, char * obj_name, size_t obj_size){
   mongoc_collection_t * collection;
   construct_access(collname, obj_name, & collection, & doc);
 
-  int64_t count = mongoc_collection_count (collection, MONGOC_QUERY_NONE, doc, 0,  0, NULL, & error );
-  if (count < 0){
+  // a point query that returns only the size of the data, or the data on servers older than 4.4
+  bson_t * opts;
+  if(stat_binary_size){
+    opts = BCON_NEW("limit", BCON_INT64(1), "projection", "{", "_id", BCON_INT32(0), "size", "{", "$binarySize", BCON_UTF8("$data"), "}", "}");
+  }else{
+    opts = BCON_NEW("limit", BCON_INT64(1), "projection", "{", "_id", BCON_INT32(0), "data", BCON_INT32(1), "}");
+  }
+  mongoc_cursor_t * cursor = mongoc_collection_find_with_opts(collection, doc, opts, NULL);
+  bson_destroy (opts);
+
+  const bson_t *element;
+  bson_iter_t iter;
+  if(mongoc_cursor_next (cursor, &element)) {
+    if(stat_binary_size){
+      if(! bson_iter_init_find(& iter, element, "size") || (size_t) bson_iter_as_int64(& iter) != obj_size){
+        ret = MD_ERROR_FIND;
+      }
+    }else if(! bson_iter_init_find(& iter, element, "data") || bson_iter_value(& iter)->value.v_binary.data_len != obj_size){
+      ret = MD_ERROR_FIND;
+    }
+  }else if(mongoc_cursor_error (cursor, & error)){
     printf("Error: %s\n", error.message);
     ret = MD_ERROR_UNKNOWN;
-  }else if(count != 1){
+  }else{
     ret = MD_ERROR_FIND;
   }
 
+  mongoc_cursor_destroy (cursor);
   free_access(collection, doc);
   return ret;
 }
@@ -303,11 +409,170 @@ static int delete_obj(char * collname, char * obj_name){
   mongoc_collection_t * collection;
   construct_access(collname, obj_name, & collection, & doc);
 
-  mongoc_collection_remove(collection, MONGOC_REMOVE_NONE, doc, NULL, & error);
+  mongoc_collection_remove(collection, MONGOC_REMOVE_NONE, doc, wc, & error);
   free_access(collection, doc);
   return MD_SUCCESS;
 }
 
+// bulk operations use the write concern and are ordered unless -u is set
+static mongoc_bulk_operation_t * new_bulk(mongoc_collection_t * collection){
+  bson_t * opts = BCON_NEW("ordered", BCON_BOOL(! unordered));
+  mongoc_write_concern_append(wc, opts);
+  mongoc_bulk_operation_t * bulk = mongoc_collection_create_bulk_operation_with_opts(collection, opts);
+  bson_destroy (opts);
+  return bulk;
+}
+
+// execute the bulk operation and set the result of each of its count operations
+// the reply of unacknowledged writes contains no errors, they are assumed to succeed
+static void execute_bulk(mongoc_bulk_operation_t * bulk, int count, int * out_ret, bson_t * reply){
+  bson_error_t error;
+  int failed = count; // the first operation not executed by an ordered bulk
+  int ok = mongoc_bulk_operation_execute(bulk, reply, & error) != 0;
+  for(int i=0; i < count; i++){
+    out_ret[i] = MD_SUCCESS;
+  }
+  if (ok){
+    return;
+  }
+  printf("Error: %s\n", error.message);
+
+  bson_iter_t iter;
+  bson_iter_t errors;
+  if (! bson_iter_init_find(& iter, reply, "writeErrors") || ! BSON_ITER_HOLDS_ARRAY(& iter) || ! bson_iter_recurse(& iter, & errors)){
+    // e.g., a connection error
+    for(int i=0; i < count; i++){
+      out_ret[i] = MD_ERROR_UNKNOWN;
+    }
+    return;
+  }
+  while(bson_iter_next(& errors)){
+    bson_iter_t index;
+    if (BSON_ITER_HOLDS_DOCUMENT(& errors) && bson_iter_recurse(& errors, & index) && bson_iter_find(& index, "index")){
+      int i = (int) bson_iter_as_int64(& index);
+      if (i >= 0 && i < count){
+        out_ret[i] = MD_ERROR_UNKNOWN;
+        failed = i < failed ? i : failed;
+      }
+    }
+  }
+  if (! unordered){
+    for(int i=failed; i < count; i++){
+      out_ret[i] = MD_ERROR_UNKNOWN;
+    }
+  }
+}
+
+// the number of processed documents according to the reply, unacknowledged writes return no count
+static int bulk_reply_count(bson_t * reply, const char * field, int * out_ret, int count){
+  bson_iter_t iter;
+  if (bson_iter_init_find(& iter, reply, field)){
+    return (int) bson_iter_as_int64(& iter);
+  }
+  int processed = 0;
+  for(int i=0; i < count; i++){
+    processed += out_ret[i] == MD_SUCCESS;
+  }
+  return processed;
+}
+
+// the end of the run of objects starting at first that go to the same collection
+static int dset_run_end(int count, char ** dsets, int first){
+  if(! collection_per_dir){
+    return count;
+  }
+  int end = first + 1;
+  while(end < count && strcmp(dsets[end], dsets[first]) == 0){
+    end++;
+  }
+  return end;
+}
+
+static int write_objs(int count, char ** dsets, char ** names, char ** bufs, size_t obj_size, int * out_ret){
+  // one bulk operation per run of objects in the same collection
+  for(int first=0; first < count; ){
+    int end = dset_run_end(count, dsets, first);
+    mongoc_collection_t * collection = collection_per_dir ? get_collection(dsets[first]) : global_collection;
+    mongoc_bulk_operation_t * bulk = new_bulk(collection);
+    for(int i=first; i < end; i++){
+      bson_t * doc = bson_new();
+      bson_append_utf8(doc, name_field(), -1, names[i], strlen(names[i]));
+      bson_append_binary(doc, "data", 4, BSON_SUBTYPE_BINARY, (const uint8_t*) bufs[i], obj_size);
+      mongoc_bulk_operation_insert(bulk, doc);
+      bson_destroy (doc);
+    }
+    bson_t reply;
+    execute_bulk(bulk, end - first, out_ret + first, & reply);
+    bson_destroy (& reply);
+    mongoc_bulk_operation_destroy(bulk);
+    first = end;
+  }
+  return MD_SUCCESS;
+}
+
+static int delete_objs(int count, char ** dsets, char ** names, int * out_ret){
+  for(int first=0; first < count; ){
+    int end = dset_run_end(count, dsets, first);
+    mongoc_collection_t * collection = collection_per_dir ? get_collection(dsets[first]) : global_collection;
+    mongoc_bulk_operation_t * bulk = new_bulk(collection);
+    for(int i=first; i < end; i++){
+      bson_t * doc = bson_new();
+      bson_append_utf8(doc, name_field(), -1, names[i], strlen(names[i]));
+      mongoc_bulk_operation_remove_one(bulk, doc);
+      bson_destroy (doc);
+    }
+    bson_t reply;
+    execute_bulk(bulk, end - first, out_ret + first, & reply);
+    bson_destroy (& reply);
+    mongoc_bulk_operation_destroy(bulk);
+    first = end;
+  }
+  return MD_SUCCESS;
+}
+
+static int bulk_create_objs(char * collname, int n, int d, int first, int last, char * buf, size_t obj_size, int * out_count){
+  char obj_name[1024];
+  mongoc_collection_t * collection = collection_per_dir ? get_collection(collname) : global_collection;
+  mongoc_bulk_operation_t * bulk = new_bulk(collection);
+  for(int i=first; i < last; i++){
+    def_obj_name(obj_name, n, d, i);
+    bson_t * doc = bson_new();
+    bson_append_utf8(doc, name_field(), -1, obj_name, strlen(obj_name));
+    bson_append_binary(doc, "data", 4, BSON_SUBTYPE_BINARY, (const uint8_t*) buf, obj_size);
+    mongoc_bulk_operation_insert(bulk, doc);
+    bson_destroy (doc);
+  }
+  bson_t reply;
+  int * ret = malloc(sizeof(int) * (last - first));
+  execute_bulk(bulk, last - first, ret, & reply);
+  *out_count = bulk_reply_count(& reply, "nInserted", ret, last - first);
+  bson_destroy (& reply);
+  mongoc_bulk_operation_destroy(bulk);
+  free(ret);
+  return *out_count == last - first ? MD_SUCCESS : MD_ERROR_UNKNOWN;
+}
+
+static int bulk_delete_objs(char * collname, int n, int d, int first, int last, int * out_count){
+  char obj_name[1024];
+  mongoc_collection_t * collection = collection_per_dir ? get_collection(collname) : global_collection;
+  mongoc_bulk_operation_t * bulk = new_bulk(collection);
+  for(int i=first; i < last; i++){
+    def_obj_name(obj_name, n, d, i);
+    bson_t * doc = bson_new();
+    bson_append_utf8(doc, name_field(), -1, obj_name, strlen(obj_name));
+    mongoc_bulk_operation_remove_one(bulk, doc);
+    bson_destroy (doc);
+  }
+  bson_t reply;
+  int * ret = malloc(sizeof(int) * (last - first));
+  execute_bulk(bulk, last - first, ret, & reply);
+  *out_count = bulk_reply_count(& reply, "nRemoved", ret, last - first);
+  bson_destroy (& reply);
+  mongoc_bulk_operation_destroy(bulk);
+  free(ret);
+  return *out_count == last - first ? MD_SUCCESS : MD_ERROR_UNKNOWN;
+}
+
 struct md_plugin md_plugin_mongo = {
   "mongo",
   get_options,
@@ -324,5 +589,35 @@ struct md_plugin md_plugin_mongo = {
   write_obj,
   read_obj,
   stat_obj,
-  delete_obj
+  delete_obj,
+
+  NULL,
+  NULL,
+  NULL,
+  NULL,
+
+  NULL,
+  NULL,
+  NULL,
+  NULL,
+  NULL,
+
+  thread_initialize,
+  thread_finalize,
+
+  write_objs,
+  NULL,
+  NULL,
+  delete_objs,
+
+  bulk_create_objs,
+  bulk_delete_objs,
+
+  NULL,
+
+  NULL,
+  NULL,
+
+  NULL,
+  NULL
 };
@@ -232,5 +232,35 @@ struct md_plugin md_plugin_mpi = {
   write_obj,
   read_obj,
   stat_obj,
-  delete_obj
+  delete_obj,
+
+  NULL,
+  NULL,
+  NULL,
+  NULL,
+
+  NULL,
+  NULL,
+  NULL,
+  NULL,
+  NULL,
+
+  NULL,
+  NULL,
+
+  NULL,
+  NULL,
+  NULL,
+  NULL,
+
+  NULL,
+  NULL,
+
+  NULL,
+
+  NULL,
+  NULL,
+
+  NULL,
+  NULL
 };
@@ -19,6 +19,7 @@
 #define MD_PLUGIN_H
 
 #include <stdlib.h>
+#include <stdint.h>
 
 #include <md_option.h>
 
@@ -46,10 +47,62 @@ struct md_plugin{
 
   // before calling these functions, use def_obj_name to set the object name
   // actually used during the benchmark to access and delete objects
+  // the buffers are aligned and padded to MEM_ALIGNMENT, see md_util.h
   int (*write_obj)(char * dset, char * name, char * buf, size_t size);
   int (*read_obj)(char * dset, char * name, char * buf, size_t size);
   int (*stat_obj)(char * dset, char * name, size_t object_size);
   int (*delete_obj)(char * dset, char * name);
+
+  // optional numeric interface that identifies the object by n == rank, d == data set id, i = object index instead of the names
+  // if a plugin provides all four functions, the synchronous benchmark loops only define the names if they are needed otherwise
+  int (*write_obj_id)(int n, int d, int i, char * buf, size_t size);
+  int (*read_obj_id)(int n, int d, int i, char * buf, size_t size);
+  int (*stat_obj_id)(int n, int d, int i, size_t object_size);
+  int (*delete_obj_id)(int n, int d, int i);
+
+  // optional asynchronous interface, a plugin may leave these NULL
+  // the submit functions return MD_SUCCESS if the operation was queued, the names and the buffer must stay valid until it completed
+  // tag is an opaque pointer of the caller that is returned once the operation completed
+  int (*submit_write_obj)(void * tag, char * dset, char * name, char * buf, size_t size);
+  int (*submit_read_obj)(void * tag, char * dset, char * name, char * buf, size_t size);
+  int (*submit_stat_obj)(void * tag, char * dset, char * name, size_t object_size);
+  int (*submit_delete_obj)(void * tag, char * dset, char * name);
+  // wait until any submitted operation completed, returns its tag and the return code of the operation
+  int (*poll_obj)(void ** out_tag, int * out_ret);
+
+  // called by each additional thread of a process before/after it uses the plugin, e.g., to create a connection per thread
+  // a plugin that does not provide these functions cannot be used with multiple threads per process
+  int (*thread_initialize)();
+  int (*thread_finalize)();
+
+  // optional batched interface used with --batch-size, a plugin may leave these NULL
+  // processes count objects at once and stores the return code of each object in out_ret
+  // if the return value is not MD_SUCCESS, it applies to all objects
+  int (*write_objs)(int count, char ** dsets, char ** names, char ** bufs, size_t size, int * out_ret);
+  int (*read_objs)(int count, char ** dsets, char ** names, char ** bufs, size_t size, int * out_ret);
+  int (*stat_objs)(int count, char ** dsets, char ** names, size_t object_size, int * out_ret);
+  int (*delete_objs)(int count, char ** dsets, char ** names, int * out_ret);
+
+  // optional bulk interface used with --bulk to precreate / clean up the objects first to last-1 of data set d of rank n at once
+  // the number of successfully processed objects is stored in out_count
+  int (*bulk_create_objs)(char * dset, int n, int d, int first, int last, char * buf, size_t size, int * out_count);
+  int (*bulk_delete_objs)(char * dset, int n, int d, int first, int last, int * out_count);
+
+  // optional, returns the number of connections established by the process so far to report them per phase
+  // returns MD_NOOP if the connections are not counted
+  int (*connection_count)(uint64_t * out_count);
+
+  // optional durability interface, a plugin may leave these NULL, they return MD_NOOP if there is nothing to sync
+  // sync_obj is called after an object was written or deleted to make the change durable, it is timed separately
+  int (*sync_obj)(char * dset, char * name);
+  // sync_dsets is called after one object of each data set of the thread was written or, in the cleanup, after the objects of a data set were deleted
+  int (*sync_dsets)();
+
+  // optional cache eviction interface used with --cold-cache, a plugin may leave these NULL, they return MD_NOOP if nothing was evicted
+  // evict_obj removes the object from the caches of the client, e.g., the page cache
+  int (*evict_obj)(char * dset, char * name);
+  // evict_caches drops the caches of the node, e.g., the dentries and inodes, it is called by one process per node
+  int (*evict_caches)();
 };
 
 enum MD_ERROR{
@@ -0,0 +1,672 @@
+// This file is part of MD-REAL-IO.
+//
+// MD-REAL-IO is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// MD-REAL-IO is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with MD-REAL-IO.  If not, see <http://www.gnu.org/licenses/>.
+//
+// Author: Julian Kunkel
+
+/*
+This plugin uses the same file system layout as the POSIX plugin but submits the operations via io_uring.
+Each object operation is a chain of linked submissions that is executed by the kernel without returning to user space:
+write: openat -> write -> close, read: openat -> read -> close, stat: statx, delete: unlinkat
+The files are opened into registered (direct) file slots and the data is transferred from registered buffers.
+The ring is used directly via the system calls, liburing is not needed.
+*/
+
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <fcntl.h>
+#include <string.h>
+#include <errno.h>
+#include <dirent.h>
+
+#include <linux/stat.h>
+#include <linux/io_uring.h>
+
+#include <plugins/md-posix-uring.h>
+
+static char * dir = "out";
+static int created_root_dir = 0;
+static int slot_count = 64;
+static int use_sqpoll = 0;
+static int sqpoll_idle_ms = 1000;
+
+static option_help options [] = {
+  {'D', "root-dir", "Root directory", OPTION_OPTIONAL_ARGUMENT, 's', & dir},
+  {'q', "max-inflight", "Maximum number of object operations in flight, each uses a registered file and buffer", OPTION_OPTIONAL_ARGUMENT, 'd', & slot_count},
+  {'s', "sqpoll", "Use a kernel thread to poll the submission queue (SQPOLL)", OPTION_FLAG, 'd', & use_sqpoll},
+  {'i', "sqpoll-idle", "Idle time in ms before the SQPOLL thread sleeps", OPTION_OPTIONAL_ARGUMENT, 'd', & sqpoll_idle_ms},
+  LAST_OPTION
+};
+
+typedef enum{
+  URING_OP_WRITE,
+  URING_OP_READ,
+  URING_OP_STAT,
+  URING_OP_DELETE
+} uring_op_t;
+
+// the state of a single object operation that may consist of multiple linked submissions
+typedef struct{
+  int in_use;
+  uring_op_t op;
+  void * tag;
+  int pending; // number of completions still to receive
+  int ret;
+  char * buf; // the buffer of the caller
+  size_t size;
+  int fixed_buf; // transfer via the registered buffer
+  struct statx stx;
+} uring_slot_t;
+
+typedef struct{
+  void * tag;
+  int ret;
+} uring_completion_t;
+
+typedef struct{
+  int fd;
+  unsigned sq_mask;
+  unsigned * sq_head;
+  unsigned * sq_tail;
+  unsigned * sq_flags;
+  unsigned * sq_array;
+  struct io_uring_sqe * sqes;
+  unsigned cq_mask;
+  unsigned * cq_head;
+  unsigned * cq_tail;
+  struct io_uring_cqe * cqes;
+  void * sq_ptr;
+  size_t sq_ptr_size;
+  void * cq_ptr;
+  size_t cq_ptr_size;
+  size_t sqes_size;
+  unsigned sq_local_tail; // entries up to here are prepared but not yet visible to the kernel
+  unsigned to_submit;
+} uring_t;
+
+// each thread uses its own ring
+static __thread uring_t ring = {.fd = -1};
+static __thread uring_slot_t * slots = NULL;
+static __thread char * slot_buffers = NULL;
+static __thread size_t slot_buffer_size = 0;
+static __thread int slot_buffers_failed = 0;
+static __thread int free_slots = 0;
+
+static __thread uring_completion_t * completions = NULL;
+static __thread int completions_count = 0;
+static __thread int completions_size = 0;
+
+static option_help * get_options(){
+  return options;
+}
+
+static int sys_io_uring_setup(unsigned entries, struct io_uring_params * p){
+  return (int) syscall(__NR_io_uring_setup, entries, p);
+}
+
+static int sys_io_uring_enter(int fd, unsigned to_submit, unsigned min_complete, unsigned flags){
+  return (int) syscall(__NR_io_uring_enter, fd, to_submit, min_complete, flags, NULL, 0);
+}
+
+static int sys_io_uring_register(int fd, unsigned opcode, void * arg, unsigned nr_args){
+  return (int) syscall(__NR_io_uring_register, fd, opcode, arg, nr_args);
+}
+
+static int ring_setup(unsigned entries){
+  struct io_uring_params p;
+  memset(& p, 0, sizeof(p));
+  if(use_sqpoll){
+    p.flags |= IORING_SETUP_SQPOLL;
+    p.sq_thread_idle = sqpoll_idle_ms;
+  }
+  p.flags |= IORING_SETUP_CQSIZE;
+  p.cq_entries = entries * 2;
+
+  ring.fd = sys_io_uring_setup(entries, & p);
+  if(ring.fd < 0){
+    printf("Error setting up io_uring: %s\n", strerror(errno));
+    return MD_ERROR_UNKNOWN;
+  }
+  if(! (p.features & IORING_FEAT_SINGLE_MMAP)){
+    printf("Error: the kernel is too old for the io_uring plugin\n");
+    return MD_ERROR_UNKNOWN;
+  }
+
+  ring.sq_ptr_size = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+  ring.cq_ptr_size = p.cq_off.cqes + p.cq_entries * sizeof(struct io_uring_cqe);
+  if(ring.cq_ptr_size > ring.sq_ptr_size){
+    ring.sq_ptr_size = ring.cq_ptr_size;
+  }
+  ring.cq_ptr_size = ring.sq_ptr_size;
+  ring.sq_ptr = mmap(NULL, ring.sq_ptr_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring.fd, IORING_OFF_SQ_RING);
+  if(ring.sq_ptr == MAP_FAILED){
+    printf("Error mapping the io_uring: %s\n", strerror(errno));
+    return MD_ERROR_UNKNOWN;
+  }
+  ring.cq_ptr = ring.sq_ptr;
+  ring.sqes_size = p.sq_entries * sizeof(struct io_uring_sqe);
+  ring.sqes = mmap(NULL, ring.sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring.fd, IORING_OFF_SQES);
+  if(ring.sqes == MAP_FAILED){
+    printf("Error mapping the io_uring: %s\n", strerror(errno));
+    return MD_ERROR_UNKNOWN;
+  }
+
+  char * sq = (char *) ring.sq_ptr;
+  ring.sq_head = (unsigned *) (sq + p.sq_off.head);
+  ring.sq_tail = (unsigned *) (sq + p.sq_off.tail);
+  ring.sq_mask = *(unsigned *) (sq + p.sq_off.ring_mask);
+  ring.sq_flags = (unsigned *) (sq + p.sq_off.flags);
+  ring.sq_array = (unsigned *) (sq + p.sq_off.array);
+
+  char * cq = (char *) ring.cq_ptr;
+  ring.cq_head = (unsigned *) (cq + p.cq_off.head);
+  ring.cq_tail = (unsigned *) (cq + p.cq_off.tail);
+  ring.cq_mask = *(unsigned *) (cq + p.cq_off.ring_mask);
+  ring.cqes = (struct io_uring_cqe *) (cq + p.cq_off.cqes);
+  ring.sq_local_tail = *ring.sq_tail;
+  ring.to_submit = 0;
+  return MD_SUCCESS;
+}
+
+static void ring_teardown(){
+  if(ring.fd < 0){
+    return;
+  }
+  munmap(ring.sqes, ring.sqes_size);
+  munmap(ring.sq_ptr, ring.sq_ptr_size);
+  close(ring.fd);
+  ring.fd = -1;
+}
+
+static struct io_uring_sqe * get_sqe(){
+  unsigned index = ring.sq_local_tail & ring.sq_mask;
+  struct io_uring_sqe * sqe = & ring.sqes[index];
+  memset(sqe, 0, sizeof(struct io_uring_sqe));
+  ring.sq_array[index] = index;
+  ring.sq_local_tail++;
+  ring.to_submit++;
+  return sqe;
+}
+
+// submit all queued entries and optionally wait for at least one completion
+static int ring_enter(unsigned min_complete){
+  unsigned flags = 0;
+  // publish the prepared entries
+  __atomic_store_n(ring.sq_tail, ring.sq_local_tail, __ATOMIC_RELEASE);
+  unsigned to_submit = ring.to_submit;
+  if(use_sqpoll){
+    // the kernel thread picks up the entries, it only needs a wakeup if it went to sleep
+    to_submit = 0;
+    if(__atomic_load_n(ring.sq_flags, __ATOMIC_ACQUIRE) & IORING_SQ_NEED_WAKEUP){
+      flags |= IORING_ENTER_SQ_WAKEUP;
+    }
+  }
+  if(min_complete > 0){
+    flags |= IORING_ENTER_GETEVENTS;
+  }
+  ring.to_submit = 0;
+  if(to_submit == 0 && flags == 0){
+    return MD_SUCCESS;
+  }
+  while(1){
+    int ret = sys_io_uring_enter(ring.fd, to_submit, min_complete, flags);
+    if(ret >= 0){
+      return MD_SUCCESS;
+    }
+    if(errno != EINTR && errno != EAGAIN && errno != EBUSY){
+      printf("Error in io_uring_enter: %s\n", strerror(errno));
+      return MD_ERROR_UNKNOWN;
+    }
+  }
+}
+
+static int queue_completion(void * tag, int ret){
+  if(completions_count == completions_size){
+    completions_size = completions_size == 0 ? 16 : completions_size * 2;
+    completions = realloc(completions, sizeof(uring_completion_t) * completions_size);
+    if(completions == NULL){
+      return MD_ERROR_UNKNOWN;
+    }
+  }
+  completions[completions_count].tag = tag;
+  completions[completions_count].ret = ret;
+  completions_count++;
+  return MD_SUCCESS;
+}
+
+// the user data encodes the slot and the position inside the chain
+#define UDATA(slot, step) ((((uint64_t) (slot)) << 2) | (step))
+
+static void process_cqe(struct io_uring_cqe * cqe){
+  int s = (int) (cqe->user_data >> 2);
+  int step = (int) (cqe->user_data & 3);
+  int res = cqe->res;
+  uring_slot_t * slot = & slots[s];
+
+  switch(slot->op){
+    case(URING_OP_WRITE):
+    case(URING_OP_READ):{
+      if(step == 0 && res < 0){
+        slot->ret = slot->op == URING_OP_WRITE ? MD_ERROR_CREATE : MD_ERROR_FIND;
+      }else if(step == 1 && slot->ret == MD_SUCCESS && (res < 0 || (size_t) res != slot->size)){
+        slot->ret = MD_ERROR_UNKNOWN;
+      }else if(step == 2 && slot->ret == MD_SUCCESS && res < 0){
+        slot->ret = MD_ERROR_UNKNOWN;
+      }
+      break;
+    }
+    case(URING_OP_STAT):{
+      if(res < 0){
+        slot->ret = MD_ERROR_FIND;
+      }else if(slot->stx.stx_size != slot->size){
+        slot->ret = MD_ERROR_FIND;
+      }
+      break;
+    }
+    case(URING_OP_DELETE):{
+      if(res < 0){
+        slot->ret = MD_ERROR_UNKNOWN;
+      }
+      break;
+    }
+  }
+
+  slot->pending--;
+  if(slot->pending == 0){
+    if(slot->op == URING_OP_READ && slot->fixed_buf && slot->ret == MD_SUCCESS){
+      memcpy(slot->buf, slot_buffers + s * slot_buffer_size, slot->size);
+    }
+    slot->in_use = 0;
+    free_slots++;
+    queue_completion(slot->tag, slot->ret);
+  }
+}
+
+// process all available completions, wait for at least one if requested
+static int reap_completions(int wait){
+  if(wait){
+    int ret = ring_enter(1);
+    if(ret != MD_SUCCESS){
+      return ret;
+    }
+  }
+  unsigned head = *ring.cq_head;
+  unsigned tail = __atomic_load_n(ring.cq_tail, __ATOMIC_ACQUIRE);
+  while(head != tail){
+    process_cqe(& ring.cqes[head & ring.cq_mask]);
+    head++;
+  }
+  __atomic_store_n(ring.cq_head, head, __ATOMIC_RELEASE);
+  return MD_SUCCESS;
+}
+
+static int register_buffers(size_t size){
+  if(slot_buffers){
+    sys_io_uring_register(ring.fd, IORING_UNREGISTER_BUFFERS, NULL, 0);
+    munmap(slot_buffers, slot_buffer_size * slot_count);
+  }
+  // keep the buffers page aligned
+  size_t page = getpagesize();
+  slot_buffer_size = (size + page - 1) / page * page;
+  slot_buffers = mmap(NULL, slot_buffer_size * slot_count, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if(slot_buffers == MAP_FAILED){
+    slot_buffers = NULL;
+    slot_buffer_size = 0;
+    return MD_ERROR_UNKNOWN;
+  }
+  struct iovec * iov = malloc(sizeof(struct iovec) * slot_count);
+  for(int i=0; i < slot_count; i++){
+    iov[i].iov_base = slot_buffers + i * slot_buffer_size;
+    iov[i].iov_len = slot_buffer_size;
+  }
+  int ret = sys_io_uring_register(ring.fd, IORING_REGISTER_BUFFERS, iov, slot_count);
+  free(iov);
+  if(ret != 0){
+    printf("Error registering io_uring buffers, using unregistered buffers: %s\n", strerror(errno));
+    slot_buffers_failed = 1;
+    munmap(slot_buffers, slot_buffer_size * slot_count);
+    slot_buffers = NULL;
+    slot_buffer_size = 0;
+    return MD_ERROR_UNKNOWN;
+  }
+  return MD_SUCCESS;
+}
+
+static int acquire_slot(uring_op_t op, void * tag, char * buf, size_t size){
+  while(free_slots == 0){
+    int ret = reap_completions(1);
+    if(ret != MD_SUCCESS){
+      return -1;
+    }
+  }
+  // (re)register the buffers when they are first needed, this is only possible if nothing is in flight
+  if(buf != NULL && size > slot_buffer_size && free_slots == slot_count && ! slot_buffers_failed){
+    register_buffers(size);
+  }
+  for(int i=0; i < slot_count; i++){
+    uring_slot_t * slot = & slots[i];
+    if(slot->in_use){
+      continue;
+    }
+    slot->in_use = 1;
+    slot->op = op;
+    slot->tag = tag;
+    slot->ret = MD_SUCCESS;
+    slot->buf = buf;
+    slot->size = size;
+    slot->fixed_buf = (buf != NULL && size <= slot_buffer_size);
+    free_slots--;
+    return i;
+  }
+  return -1;
+}
+
+static void prep_data_chain(int s, char * name, int open_flags, int data_opcode){
+  uring_slot_t * slot = & slots[s];
+  struct io_uring_sqe * sqe;
+
+  // open into the registered file table at the position of the slot
+  sqe = get_sqe();
+  sqe->opcode = IORING_OP_OPENAT;
+  sqe->fd = AT_FDCWD;
+  sqe->addr = (uint64_t) (uintptr_t) name;
+  sqe->open_flags = open_flags;
+  sqe->len = 0644;
+  sqe->file_index = s + 1;
+  sqe->flags = IOSQE_IO_LINK;
+  sqe->user_data = UDATA(s, 0);
+
+  // the hard link ensures the file is closed even if the transfer was short
+  sqe = get_sqe();
+  sqe->fd = s;
+  sqe->flags = IOSQE_FIXED_FILE | IOSQE_IO_HARDLINK;
+  sqe->len = slot->size;
+  sqe->off = 0;
+  if(slot->fixed_buf){
+    sqe->opcode = data_opcode == IORING_OP_READ ? IORING_OP_READ_FIXED : IORING_OP_WRITE_FIXED;
+    sqe->addr = (uint64_t) (uintptr_t) (slot_buffers + s * slot_buffer_size);
+    sqe->buf_index = s;
+  }else{
+    sqe->opcode = data_opcode;
+    sqe->addr = (uint64_t) (uintptr_t) slot->buf;
+  }
+  sqe->user_data = UDATA(s, 1);
+
+  sqe = get_sqe();
+  sqe->opcode = IORING_OP_CLOSE;
+  sqe->file_index = s + 1;
+  sqe->user_data = UDATA(s, 2);
+
+  slot->pending = 3;
+}
+
+static int submit_write_obj(void * tag, char * dirname, char * filename, char * buf, size_t file_size){
+  int s = acquire_slot(URING_OP_WRITE, tag, buf, file_size);
+  if(s < 0) return MD_ERROR_UNKNOWN;
+  if(slots[s].fixed_buf){
+    memcpy(slot_buffers + s * slot_buffer_size, buf, file_size);
+  }
+  prep_data_chain(s, filename, O_CREAT | O_TRUNC | O_WRONLY, IORING_OP_WRITE);
+  return ring_enter(0);
+}
+
+static int submit_read_obj(void * tag, char * dirname, char * filename, char * buf, size_t file_size){
+  int s = acquire_slot(URING_OP_READ, tag, buf, file_size);
+  if(s < 0) return MD_ERROR_UNKNOWN;
+  prep_data_chain(s, filename, O_RDONLY, IORING_OP_READ);
+  return ring_enter(0);
+}
+
+static int submit_stat_obj(void * tag, char * dirname, char * filename, size_t file_size){
+  int s = acquire_slot(URING_OP_STAT, tag, NULL, file_size);
+  if(s < 0) return MD_ERROR_UNKNOWN;
+  struct io_uring_sqe * sqe = get_sqe();
+  sqe->opcode = IORING_OP_STATX;
+  sqe->fd = AT_FDCWD;
+  sqe->addr = (uint64_t) (uintptr_t) filename;
+  sqe->len = STATX_SIZE;
+  sqe->off = (uint64_t) (uintptr_t) & slots[s].stx;
+  sqe->user_data = UDATA(s, 0);
+  slots[s].pending = 1;
+  return ring_enter(0);
+}
+
+static int submit_delete_obj(void * tag, char * dirname, char * filename){
+  int s = acquire_slot(URING_OP_DELETE, tag, NULL, 0);
+  if(s < 0) return MD_ERROR_UNKNOWN;
+  struct io_uring_sqe * sqe = get_sqe();
+  sqe->opcode = IORING_OP_UNLINKAT;
+  sqe->fd = AT_FDCWD;
+  sqe->addr = (uint64_t) (uintptr_t) filename;
+  sqe->user_data = UDATA(s, 0);
+  slots[s].pending = 1;
+  return ring_enter(0);
+}
+
+static int poll_obj(void ** out_tag, int * out_ret){
+  while(completions_count == 0){
+    if(free_slots == slot_count){
+      return MD_ERROR_FIND; // nothing in flight
+    }
+    int ret = reap_completions(1);
+    if(ret != MD_SUCCESS){
+      return ret;
+    }
+  }
+  completions_count--;
+  *out_tag = completions[completions_count].tag;
+  *out_ret = completions[completions_count].ret;
+  return MD_SUCCESS;
+}
+
+// the synchronous interface submits the operation and waits for its completion
+static int wait_for(void * tag){
+  while(1){
+    for(int i = completions_count - 1; i >= 0; i--){
+      if(completions[i].tag == tag){
+        int ret = completions[i].ret;
+        completions[i] = completions[completions_count - 1];
+        completions_count--;
+        return ret;
+      }
+    }
+    int ret = reap_completions(1);
+    if(ret != MD_SUCCESS){
+      return ret;
+    }
+  }
+}
+
+static int write_obj(char * dirname, char * filename, char * buf, size_t file_size){
+  int tag;
+  int ret = submit_write_obj(& tag, dirname, filename, buf, file_size);
+  if(ret != MD_SUCCESS) return ret;
+  return wait_for(& tag);
+}
+
+static int read_obj(char * dirname, char * filename, char * buf, size_t file_size){
+  int tag;
+  int ret = submit_read_obj(& tag, dirname, filename, buf, file_size);
+  if(ret != MD_SUCCESS) return ret;
+  return wait_for(& tag);
+}
+
+static int stat_obj(char * dirname, char * filename, size_t file_size){
+  int tag;
+  int ret = submit_stat_obj(& tag, dirname, filename, file_size);
+  if(ret != MD_SUCCESS) return ret;
+  return wait_for(& tag);
+}
+
+static int delete_obj(char * dirname, char * filename){
+  int tag;
+  int ret = submit_delete_obj(& tag, dirname, filename);
+  if(ret != MD_SUCCESS) return ret;
+  return wait_for(& tag);
+}
+
+static int initialize(){
+  if(slot_count < 1){
+    printf("Error: the number of operations in flight must be at least 1\n");
+    return MD_ERROR_UNKNOWN;
+  }
+  // each object operation needs up to three submission entries
+  int ret = ring_setup(slot_count * 3);
+  if(ret != MD_SUCCESS){
+    ring_teardown();
+    return ret;
+  }
+
+  // a sparse table of registered files, the files are opened directly into it
+  int * fds = malloc(sizeof(int) * slot_count);
+  for(int i=0; i < slot_count; i++){
+    fds[i] = -1;
+  }
+  ret = sys_io_uring_register(ring.fd, IORING_REGISTER_FILES, fds, slot_count);
+  free(fds);
+  if(ret != 0){
+    printf("Error registering io_uring files: %s\n", strerror(errno));
+    ring_teardown();
+    return MD_ERROR_UNKNOWN;
+  }
+
+  slots = calloc(slot_count, sizeof(uring_slot_t));
+  free_slots = slot_count;
+  return MD_SUCCESS;
+}
+
+static int finalize(){
+  if(slot_buffers){
+    munmap(slot_buffers, slot_buffer_size * slot_count);
+    slot_buffers = NULL;
+    slot_buffer_size = 0;
+  }
+  ring_teardown();
+  free(slots);
+  slots = NULL;
+  free(completions);
+  completions = NULL;
+  completions_count = completions_size = 0;
+  return MD_SUCCESS;
+}
+
+static int prepare_global(){
+  int ret = mkdir(dir, 0755);
+  if(ret != 0){
+    // check if the directory is empty
+    DIR * d = opendir(dir);
+    if( d == NULL ) goto err;
+    struct dirent * entry;
+    int i;
+    for(i=0; i < 10; i++){
+      entry = readdir(d);
+      if(entry == NULL){
+        break;
+      }
+    }
+    closedir(d);
+
+    if (i == 2){
+      printf("WARN: Will use the existing (empty) directory\n");
+      return MD_SUCCESS;
+    }
+    err:
+      printf("ERROR: Could not create the directory: %s; error: %s\n", dir, strerror(errno));
+      return MD_EXISTS;
+  }
+  created_root_dir = 1;
+  return MD_SUCCESS;
+}
+
+static int purge_global(){
+  if(created_root_dir){
+    return rmdir(dir);
+  }
+  return MD_SUCCESS;
+}
+
+static int def_dset_name(char * out_name, int n, int d){
+  sprintf(out_name, "%s/%d_%d", dir, n, d);
+  return MD_SUCCESS;
+}
+
+static int def_obj_name(char * out_name, int n, int d, int i){
+  sprintf(out_name, "%s/%d_%d/file-%d", dir, n, d, i);
+  return MD_SUCCESS;
+}
+
+static int create_dset(char * filename){
+  return mkdir(filename, 0755);
+}
+
+static int rm_dset(char * filename){
+  return rmdir(filename);
+}
+
+
+struct md_plugin md_plugin_posix_uring = {
+  "posix-uring",
+  get_options,
+  initialize,
+  finalize,
+  prepare_global,
+  purge_global,
+
+  def_dset_name,
+  create_dset,
+  rm_dset,
+
+  def_obj_name,
+  write_obj,
+  read_obj,
+  stat_obj,
+  delete_obj,
+
+  NULL,
+  NULL,
+  NULL,
+  NULL,
+
+  submit_write_obj,
+  submit_read_obj,
+  submit_stat_obj,
+  submit_delete_obj,
+  poll_obj,
+
+  initialize,
+  finalize,
+
+  NULL,
+  NULL,
+  NULL,
+  NULL,
+
+  NULL,
+  NULL,
+
+  NULL,
+
+  NULL,
+  NULL,
+
+  NULL,
+  NULL
+};
@@ -15,6 +15,9 @@
 //
 // Author: Julian Kunkel
 
+// O_PATH and statx
+#define _GNU_SOURCE
+
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <unistd.h>
@@ -26,12 +29,34 @@
 #include <assert.h>
 
 #include <plugins/md-posix.h>
+#include <md_util.h>
 
 static char * dir = "out";
 static int created_root_dir = 0;
+static int use_dirfd = 0;
+static char * sync_mode_name = "none";
+static int dir_sync = 0;
+static int direct_io = 0;
+static int drop_caches = 0;
+
+typedef enum{
+  SYNC_NONE,
+  SYNC_FSYNC,
+  SYNC_FDATASYNC,
+  SYNC_OSYNC,
+  SYNC_ODSYNC,
+  SYNC_SYNCFS
+} sync_mode_t;
+
+static sync_mode_t sync_mode = SYNC_NONE;
 
 static option_help options [] = {
   {'D', "root-dir", "Root directory", OPTION_OPTIONAL_ARGUMENT, 's', & dir},
+  {'a', "use-dirfd", "Open each data set directory once and access the objects relative to it with the *at() calls, i.e., without walking the full path.", OPTION_FLAG, 'd', & use_dirfd},
+  {'s', "sync", "Durability of the objects: none, fsync or fdatasync after each write, osync or odsync to open the objects with O_SYNC / O_DSYNC, syncfs after one object of each data set was written.", OPTION_OPTIONAL_ARGUMENT, 's', & sync_mode_name},
+  {'d', "direct", "Read and write the objects with O_DIRECT bypassing the page cache, the I/O size is padded to 4 KiB.", OPTION_FLAG, 'd', & direct_io},
+  {'c', "drop-caches", "With --cold-cache, drop the dentries and inodes of the node via /proc/sys/vm/drop_caches, requires root.", OPTION_FLAG, 'd', & drop_caches},
+  {'y', "dir-sync", "Fsync the data set directory after an object was created or deleted.", OPTION_FLAG, 'd', & dir_sync},
   LAST_OPTION
 };
 
@@ -39,11 +64,88 @@ static option_help * get_options(){
   return options;
 }
 
+// with -a, each thread keeps an O_PATH descriptor per data set directory until the data set is removed
+static __thread cache_t dirfds;
+
+static int get_dirfd(char * dirname){
+  cache_entry_t * e = cache_find(& dirfds, dirname);
+  if(e != NULL){
+    return (int) (intptr_t) e->value;
+  }
+  int fd = open(dirname, O_PATH | O_DIRECTORY);
+  if(fd == -1){
+    return -1;
+  }
+  cache_insert(& dirfds, dirname, (void *) (intptr_t) fd);
+  return fd;
+}
+
+static void close_dirfd(void * fd){
+  close((int) (intptr_t) fd);
+}
+
+static void release_dirfd(char * dirname){
+  if(cache_find(& dirfds, dirname) != NULL){
+    close_dirfd(cache_remove(& dirfds, dirname));
+  }
+}
+
+static void free_dirfds(){
+  cache_free(& dirfds, close_dirfd);
+}
+
+// returns the directory and the name relative to it to access the object
+static int resolve(char * dirname, char * filename, char ** out_name){
+  if(! use_dirfd){
+    *out_name = filename;
+    return AT_FDCWD;
+  }
+  char * leaf = strrchr(filename, '/');
+  *out_name = leaf == NULL ? filename : leaf + 1;
+  return get_dirfd(dirname);
+}
+
+// with --sync=fsync or fdatasync, the written object stays open until it is synced
+static __thread int unsynced_fd = -1;
+// the root directory to sync the file system with --sync=syncfs
+static __thread int root_fd = -1;
+
+static void close_sync_fds(){
+  if(unsynced_fd != -1){
+    close(unsynced_fd);
+    unsynced_fd = -1;
+  }
+  if(root_fd != -1){
+    close(root_fd);
+    root_fd = -1;
+  }
+}
+
 static int initialize(){
-  return MD_SUCCESS;
+  const char * names[] = {"none", "fsync", "fdatasync", "osync", "odsync", "syncfs"};
+  for(int i=0; i <= SYNC_SYNCFS; i++){
+    if(strcmp(sync_mode_name, names[i]) == 0){
+      sync_mode = (sync_mode_t) i;
+      return MD_SUCCESS;
+    }
+  }
+  printf("ERROR: Unknown sync mode: %s\n", sync_mode_name);
+  return MD_ERROR_UNKNOWN;
 }
 
 static int finalize(){
+  free_dirfds();
+  close_sync_fds();
+  return MD_SUCCESS;
+}
+
+static int thread_initialize(){
+  return MD_SUCCESS;
+}
+
+static int thread_finalize(){
+  free_dirfds();
+  close_sync_fds();
   return MD_SUCCESS;
 }
 
@@ -88,27 +190,56 @@ static int purge_global(){
 }
 
 static int def_dset_name(char * out_name, int n, int d){
-  sprintf(out_name, "%s/%d_%d", dir, n, d);
+  char * pos = format_int(format_str(format_str(out_name, dir), "/"), n);
+  format_int(format_str(pos, "_"), d);
   return MD_SUCCESS;
 }
 
 static int def_obj_name(char * out_name, int n, int d, int i){
-  sprintf(out_name, "%s/%d_%d/file-%d", dir, n, d, i);
+  char * pos = format_int(format_str(format_str(out_name, dir), "/"), n);
+  pos = format_int(format_str(pos, "_"), d);
+  format_int(format_str(pos, "/file-"), i);
   return MD_SUCCESS;
 }
 
 static int create_dset(char * filename){
-  return mkdir(filename, 0755);
+  int ret = mkdir(filename, 0755);
+  if(ret == 0 && use_dirfd){
+    get_dirfd(filename);
+  }
+  return ret;
 }
 
 static int rm_dset(char * filename){
+  if(use_dirfd){
+    release_dirfd(filename);
+  }
   return rmdir(filename);
 }
 
 static int write_obj(char * dirname, char * filename, char * buf, size_t file_size){
   ssize_t ret;
   int fd;
-  fd = open(filename, O_CREAT | O_TRUNC | O_RDWR, 0644);
+  char * name;
+  int flags = O_CREAT | O_TRUNC | O_RDWR;
+  if (direct_io){
+    // the buffers of md-workbench are padded
+    flags |= O_DIRECT;
+    file_size = MEM_PADDED_SIZE(file_size);
+  }
+  if (sync_mode == SYNC_OSYNC){
+    flags |= O_SYNC;
+  }else if (sync_mode == SYNC_ODSYNC){
+    flags |= O_DSYNC;
+  }
+  if (unsynced_fd != -1){
+    // the previous object was not synced
+    close(unsynced_fd);
+    unsynced_fd = -1;
+  }
+  int dirfd = resolve(dirname, filename, & name);
+  if (dirfd == -1) return MD_ERROR_FIND;
+  fd = openat(dirfd, name, flags, 0644);
   if (fd == -1) return MD_ERROR_CREATE;
 
   while(file_size > 0){
@@ -125,6 +256,10 @@ static int write_obj(char * dirname, char * filename, char * buf, size_t file_si
     file_size -= ret;
     buf += ret;
   }
+  if (sync_mode == SYNC_FSYNC || sync_mode == SYNC_FDATASYNC){
+    unsynced_fd = fd;
+    return MD_SUCCESS;
+  }
   close(fd);
   return MD_SUCCESS;
 }
@@ -133,7 +268,13 @@ static int write_obj(char * dirname, char * filename, char * buf, size_t file_si
 static int read_obj(char * dirname, char * filename, char * buf, size_t file_size){
   int fd;
   int ret;
-  fd = open(filename, O_RDWR);
+  char * name;
+  int dirfd = resolve(dirname, filename, & name);
+  if (dirfd == -1) return MD_ERROR_FIND;
+  if (direct_io){
+    file_size = MEM_PADDED_SIZE(file_size);
+  }
+  fd = openat(dirfd, name, direct_io ? O_RDWR | O_DIRECT : O_RDWR);
   if (fd == -1) return MD_ERROR_FIND;
 
   while(file_size > 0){
@@ -158,9 +299,23 @@ static int read_obj(char * dirname, char * filename, char * buf, size_t file_siz
 }
 
 static int stat_obj(char * dirname, char * filename, size_t file_size){
-  struct stat file_stats;
   int ret;
-  ret = stat(filename, & file_stats);
+  if(! use_dirfd){
+    struct stat file_stats;
+    ret = stat(filename, & file_stats);
+  }else{
+    char * name;
+    int dirfd = resolve(dirname, filename, & name);
+    if (dirfd == -1) return MD_ERROR_FIND;
+#ifdef STATX_SIZE
+    // only the size is requested, the file system may skip fetching the other attributes
+    struct statx file_stats;
+    ret = statx(dirfd, name, 0, STATX_SIZE, & file_stats);
+#else
+    struct stat file_stats;
+    ret = fstatat(dirfd, name, & file_stats, 0);
+#endif
+  }
   if ( ret != 0 ){
     return MD_ERROR_FIND;
   }
@@ -168,7 +323,84 @@ static int stat_obj(char * dirname, char * filename, size_t file_size){
 }
 
 static int delete_obj(char * dirname, char * filename){
-  return unlink(filename);
+  char * name;
+  int dirfd = resolve(dirname, filename, & name);
+  if (dirfd == -1) return MD_ERROR_FIND;
+  return unlinkat(dirfd, name, 0);
+}
+
+static int sync_obj(char * dirname, char * filename){
+  int ret = MD_NOOP;
+  if (unsynced_fd != -1){
+    // the object was just written
+    int err = sync_mode == SYNC_FSYNC ? fsync(unsynced_fd) : fdatasync(unsynced_fd);
+    close(unsynced_fd);
+    unsynced_fd = -1;
+    if (err != 0){
+      printf("Error syncing %s: %s\n", filename, strerror(errno));
+      return MD_ERROR_UNKNOWN;
+    }
+    ret = MD_SUCCESS;
+  }
+  if (dir_sync){
+    // the O_PATH descriptors of --use-dirfd cannot be synced
+    int fd = open(dirname, O_RDONLY | O_DIRECTORY);
+    if (fd == -1) return MD_ERROR_FIND;
+    int err = fsync(fd);
+    close(fd);
+    if (err != 0){
+      printf("Error syncing %s: %s\n", dirname, strerror(errno));
+      return MD_ERROR_UNKNOWN;
+    }
+    ret = MD_SUCCESS;
+  }
+  return ret;
+}
+
+// the eviction is not timed and also touches the data sets of other processes, hence,
+// the object is opened by its path to keep their directories out of the --use-dirfd cache
+static int evict_obj(char * dirname, char * filename){
+  int fd = open(filename, O_RDONLY);
+  if (fd == -1) return MD_ERROR_FIND;
+  // dirty pages are not dropped
+  int ret = fdatasync(fd);
+  if (ret == 0){
+    ret = posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+  }
+  close(fd);
+  return ret == 0 ? MD_SUCCESS : MD_ERROR_UNKNOWN;
+}
+
+static int evict_caches(){
+  if (! drop_caches){
+    return MD_NOOP;
+  }
+  sync();
+  int fd = open("/proc/sys/vm/drop_caches", O_WRONLY);
+  if (fd == -1){
+    printf("WARN: Cannot drop the caches: %s\n", strerror(errno));
+    drop_caches = 0;
+    return MD_NOOP;
+  }
+  // 2: free the dentries and inodes, the data of the objects is evicted individually
+  ssize_t ret = write(fd, "2", 1);
+  close(fd);
+  return ret == 1 ? MD_SUCCESS : MD_ERROR_UNKNOWN;
+}
+
+static int sync_dsets(){
+  if (sync_mode != SYNC_SYNCFS){
+    return MD_NOOP;
+  }
+  if (root_fd == -1){
+    root_fd = open(dir, O_RDONLY | O_DIRECTORY);
+    if (root_fd == -1) return MD_ERROR_FIND;
+  }
+  if (syncfs(root_fd) != 0){
+    printf("Error syncing the file system of %s: %s\n", dir, strerror(errno));
+    return MD_ERROR_UNKNOWN;
+  }
+  return MD_SUCCESS;
 }
 
 
@@ -190,5 +422,35 @@ struct md_plugin md_plugin_posix = {
   write_obj,
   read_obj,
   stat_obj,
-  delete_obj
+  delete_obj,
+
+  NULL,
+  NULL,
+  NULL,
+  NULL,
+
+  NULL,
+  NULL,
+  NULL,
+  NULL,
+  NULL,
+
+  thread_initialize,
+  thread_finalize,
+
+  NULL,
+  NULL,
+  NULL,
+  NULL,
+
+  NULL,
+  NULL,
+
+  NULL,
+
+  sync_obj,
+  sync_dsets,
+
+  evict_obj,
+  evict_caches
 };
@@ -24,15 +24,21 @@ Anyway the schema is always:
 (name VARCHAR PRIMARY KEY, data BYTEA)
 
 Stat checks that the file size matches our expected file size
+
+The object names and data are passed as binary parameters, with -p the statements are prepared once per table and connection.
+With --queue-depth, the statements are sent using the pipeline mode of libpq (version 14 or newer).
 */
 
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <stdint.h>
+#include <arpa/inet.h>
 
 #include <libpq-fe.h>
 
 #include <plugins/md-postgres.h>
+#include <md_util.h>
 
 static char * database = "";
 static char * username = "";
@@ -42,6 +48,7 @@ static char * pq_options = "";
 static char * tbl_name = "md_real_io";
 
 static int table_per_dset = 0;
+static int use_prepared = 0;
 
 static option_help options [] = {
   {'D', "database", "Database name, this temporary database will be used for the test.", OPTION_REQUIRED_ARGUMENT, 's', & database},
@@ -51,10 +58,11 @@ static option_help options [] = {
   {'T', "table-name", "Name of the table", OPTION_OPTIONAL_ARGUMENT, 's', & tbl_name},
   {'P', "password", "Passwort, if empty no password is assumed.", OPTION_OPTIONAL_ARGUMENT, 'H', & password},
   {'t', "use-table-per-tbl_name", "Create one table per tbl_nameectory, otherwise a global table is used", OPTION_FLAG, 'd', & table_per_dset},
+  {'p', "prepared", "Prepare the statements once per table and connection instead of parsing them for each operation", OPTION_FLAG, 'd', & use_prepared},
   LAST_OPTION
 };
 
-static PGconn * conn = NULL;
+static __thread PGconn * conn = NULL; // one connection per thread
 
 static option_help * get_options(){
   return options;
@@ -136,17 +144,22 @@ static int initialize(){
   return MD_SUCCESS;
 }
 
+// frees the state of the statements of the thread
+static void prepared_free();
+static int prepare_table(char * dset_name);
+
 static int finalize(){
   PQfinish(conn);
   conn = NULL;
+  prepared_free();
   return MD_SUCCESS;
 }
 
 static int def_dset_name(char * out_name, int n, int d){
+  char * pos = format_str(out_name, tbl_name);
   if( table_per_dset ){
-    sprintf(out_name, "%s_%d_%d", tbl_name, n, d);
-  }else{
-    sprintf(out_name, "%s", tbl_name);
+    pos = format_int(format_str(pos, "_"), n);
+    format_int(format_str(pos, "_"), d);
   }
   return MD_SUCCESS;
 }
@@ -167,6 +180,9 @@ static int create_dset(char * dset_name){
     return MD_ERROR_UNKNOWN;
   }
   PQclear(res);
+  if (use_prepared){
+    return prepare_table(dset_name);
+  }
   return MD_SUCCESS;
 }
 
@@ -190,94 +206,611 @@ static int rm_dset(char * obj_name){
 
 static int def_obj_name(char * out_name, int n, int d, int i){
   if( table_per_dset ){
-    sprintf(out_name, "%d", i);
+    format_int(out_name, i);
   }else{
-    sprintf(out_name, "%d/%d/%d", n, d, i);
+    char * pos = format_int(out_name, n);
+    pos = format_int(format_str(pos, "/"), d);
+    format_int(format_str(pos, "/"), i);
   }
   return MD_SUCCESS;
 }
 
 
-static int write_obj(char * dset_name, char * obj_name, char * buf, size_t obj_size){
+// the statements of the object operations, the parameters are transferred in binary format
+typedef enum{
+  STMT_WRITE,
+  STMT_READ,
+  STMT_STAT,
+  STMT_DELETE,
+  STMT_COUNT
+} stmt_t;
+
+static const char * stmt_sql[STMT_COUNT] = {
+  "INSERT INTO %s(obj_name, data) VALUES($1, $2)",
+  "SELECT data FROM %s WHERE obj_name = $1",
+  "SELECT octet_length(data) FROM %s WHERE obj_name = $1",
+  "DELETE FROM %s WHERE obj_name = $1"
+};
+
+// the OIDs of VARCHAR and BYTEA
+static const Oid stmt_types[2] = {1043, 17};
+static const int stmt_formats[2] = {1, 1};
+
+static void stmt_name(char * out_name, stmt_t stmt, char * dset_name){
+  out_name[0] = "wrsd"[stmt];
+  out_name[1] = '_';
+  format_str(out_name + 2, dset_name);
+}
+
+static int stmt_params(stmt_t stmt){
+  return stmt == STMT_WRITE ? 2 : 1;
+}
+
+#ifdef LIBPQ_HAS_PIPELINING
+static void pending_push(void * tag, stmt_t stmt, int statements, char * buf, size_t size);
+static int pending_prepare(char * dset_name);
+static void pending_free();
+#endif
+
+// the tables for which the statements are prepared on the connection of the thread
+static __thread cache_t prepared_tables;
+
+// returns 1 if the statements of the table are prepared
+static int prepared_lookup(char * dset_name){
+  return cache_find(& prepared_tables, dset_name) != NULL;
+}
+
+static void prepared_insert(char * dset_name){
+  cache_insert(& prepared_tables, dset_name, NULL);
+}
+
+// a statement that has been prepared by an earlier, partially failed attempt is fine
+static int prepare_result_ok(PGresult * res){
+  char * state = PQresultErrorField(res, PG_DIAG_SQLSTATE);
+  return PQresultStatus(res) == PGRES_COMMAND_OK || (state != NULL && strcmp(state, "42P05") == 0);
+}
+
+static void prepared_free(){
+#ifdef LIBPQ_HAS_PIPELINING
+  pending_free();
+#endif
+  cache_free(& prepared_tables, NULL);
+}
+
+// prepare the statements of the table once per connection, the table is recorded once all statements are prepared
+// in pipeline mode the statements are queued and poll_obj() records the table when it consumes their results
+static int prepare_table(char * dset_name){
+  char name[4096];
   char SQL[4096];
-  sprintf(SQL, "INSERT INTO %s(obj_name, data) VALUES('%s', $1::bytea)", dset_name, obj_name);
-  PGresult * res;
-  //printf("%s\n", obj_name);
-  int paramFormats = 1;
-  const int size = (int) obj_size;
-  res = PQexecParams(conn, SQL, 1, NULL, (const char * const *) & buf, & size, & paramFormats, 1);
-  if (PQresultStatus(res) != PGRES_COMMAND_OK){
-    printf("PSQL error (%s): %s - Connection: %s SQL: %s\n", PQresStatus(PQresultStatus(res)), PQresultErrorMessage(res), PQerrorMessage(conn), SQL);
+  if(prepared_lookup(dset_name)){
+    return MD_SUCCESS;
+  }
+#ifdef LIBPQ_HAS_PIPELINING
+  if(PQpipelineStatus(conn) != PQ_PIPELINE_OFF){
+    if(pending_prepare(dset_name)){
+      return MD_SUCCESS;
+    }
+    for(int stmt=0; stmt < STMT_COUNT; stmt++){
+      stmt_name(name, stmt, dset_name);
+      sprintf(SQL, stmt_sql[stmt], dset_name);
+      if(! PQsendPrepare(conn, name, SQL, stmt_params(stmt), stmt_types)){
+        printf("PSQL error: %s\n", PQerrorMessage(conn));
+        return MD_ERROR_UNKNOWN;
+      }
+    }
+    PQpipelineSync(conn);
+    pending_push(NULL, STMT_COUNT, STMT_COUNT, strdup(dset_name), 0);
+    return MD_SUCCESS;
+  }
+#endif
+  for(int stmt=0; stmt < STMT_COUNT; stmt++){
+    stmt_name(name, stmt, dset_name);
+    sprintf(SQL, stmt_sql[stmt], dset_name);
+    PGresult * res = PQprepare(conn, name, SQL, stmt_params(stmt), stmt_types);
+    if (! prepare_result_ok(res)){
+      printf("PSQL error (%s): %s - Connection: %s SQL: %s\n", PQresStatus(PQresultStatus(res)), PQresultErrorMessage(res), PQerrorMessage(conn), SQL);
+      PQclear(res);
+      return MD_ERROR_UNKNOWN;
+    }
     PQclear(res);
-    return MD_ERROR_UNKNOWN;
   }
-  PQclear(res);
+  prepared_insert(dset_name);
   return MD_SUCCESS;
 }
 
-static int read_obj(char * dset_name, char * obj_name, char * buf, size_t obj_size){
-  char SQL[4096];
-  sprintf(SQL, "SELECT data FROM %s WHERE obj_name = '%s'", dset_name, obj_name);
-  PGresult * res;
-  res = PQexecParams(conn, SQL, 0, NULL, NULL, NULL, NULL, 1);
-  if (PQresultStatus(res) != PGRES_TUPLES_OK || PQntuples(res) != 1){
-    printf("PSQL error (%s): %s - Connection: %s SQL: %s\n", PQresStatus(PQresultStatus(res)), PQresultErrorMessage(res), PQerrorMessage(conn), SQL);
+// checks the result of an object operation and clears it
+static int stmt_result(stmt_t stmt, PGresult * res, char * buf, size_t obj_size){
+  ExecStatusType expected = (stmt == STMT_READ || stmt == STMT_STAT) ? PGRES_TUPLES_OK : PGRES_COMMAND_OK;
+  if (PQresultStatus(res) != expected){
+    printf("PSQL error (%s): %s - Connection: %s\n", PQresStatus(PQresultStatus(res)), PQresultErrorMessage(res), PQerrorMessage(conn));
     PQclear(res);
     return MD_ERROR_UNKNOWN;
   }
+  int ret = MD_SUCCESS;
+  uint32_t size;
+  switch(stmt){
+    case(STMT_READ):
+      if (PQntuples(res) != 1 || (size_t) PQgetlength(res, 0, 0) != obj_size){
+        ret = MD_ERROR_UNKNOWN;
+        break;
+      }
+      memcpy(buf, PQgetvalue(res, 0, 0), obj_size);
+      break;
+    case(STMT_STAT):
+      if (PQntuples(res) != 1){
+        ret = MD_ERROR_UNKNOWN;
+        break;
+      }
+      // the binary representation of an integer is in network byte order
+      memcpy(& size, PQgetvalue(res, 0, 0), sizeof(size));
+      if (ntohl(size) != obj_size){
+        ret = MD_ERROR_FIND;
+      }
+      break;
+    case(STMT_DELETE):
+      if (strcmp(PQcmdTuples(res), "1") != 0){
+        ret = MD_ERROR_UNKNOWN;
+      }
+      break;
+    default:
+      break;
+  }
+  PQclear(res);
+  return ret;
+}
+
+static int exec_stmt(stmt_t stmt, char * dset_name, char * obj_name, char * buf, size_t obj_size){
+  const char * values[2] = {obj_name, buf};
+  const int lengths[2] = {(int) strlen(obj_name), (int) obj_size};
+  PGresult * res;
+  if (use_prepared){
+    char name[4096];
+    int ret = prepare_table(dset_name);
+    if (ret != MD_SUCCESS){
+      return ret;
+    }
+    stmt_name(name, stmt, dset_name);
+    res = PQexecPrepared(conn, name, stmt_params(stmt), values, lengths, stmt_formats, 1);
+  }else{
+    char SQL[4096];
+    sprintf(SQL, stmt_sql[stmt], dset_name);
+    res = PQexecParams(conn, SQL, stmt_params(stmt), stmt_types, values, lengths, stmt_formats, 1);
+  }
+  return stmt_result(stmt, res, buf, obj_size);
+}
+
+static int write_obj(char * dset_name, char * obj_name, char * buf, size_t obj_size){
+  return exec_stmt(STMT_WRITE, dset_name, obj_name, buf, obj_size);
+}
+
+static int read_obj(char * dset_name, char * obj_name, char * buf, size_t obj_size){
+  return exec_stmt(STMT_READ, dset_name, obj_name, buf, obj_size);
+}
+
+static int stat_obj(char * dset_name, char * obj_name, size_t obj_size){
+  return exec_stmt(STMT_STAT, dset_name, obj_name, NULL, obj_size);
+}
+
+static int delete_obj(char * dset_name, char * obj_name){
+  return exec_stmt(STMT_DELETE, dset_name, obj_name, NULL, 0);
+}
+
+#ifdef LIBPQ_HAS_PIPELINING
+/*
+ The asynchronous interface uses the pipeline mode of libpq, each statement is followed by a sync point to isolate errors.
+ The connection enters the pipeline mode with the first submitted statement and leaves it once all results have been consumed.
+ */
+typedef struct{
+  void * tag; // NULL for statements that are not visible to the caller
+  stmt_t stmt;
+  int statements; // the number of results before the sync point
+  char * buf; // the name of the table for the statements of prepare_table()
+  size_t size;
+} pending_t;
+
+static __thread pending_t * pending = NULL;
+static __thread int pending_size = 0;
+static __thread int pending_head = 0;
+static __thread int pending_count = 0;
+
+static void pending_push(void * tag, stmt_t stmt, int statements, char * buf, size_t size){
+  if(pending_count == pending_size){
+    int size = pending_size == 0 ? 16 : pending_size * 2;
+    pending_t * p = malloc(sizeof(pending_t) * size);
+    for(int i=0; i < pending_count; i++){
+      p[i] = pending[(pending_head + i) % pending_size];
+    }
+    free(pending);
+    pending = p;
+    pending_size = size;
+    pending_head = 0;
+  }
+  pending_t * p = & pending[(pending_head + pending_count) % pending_size];
+  p->tag = tag;
+  p->stmt = stmt;
+  p->statements = statements;
+  p->buf = buf;
+  p->size = size;
+  pending_count++;
+}
+
+// returns 1 if the statements of the table are queued but their results have not been consumed yet
+static int pending_prepare(char * dset_name){
+  for(int i=0; i < pending_count; i++){
+    pending_t * p = & pending[(pending_head + i) % pending_size];
+    if(p->tag == NULL && strcmp(p->buf, dset_name) == 0){
+      return 1;
+    }
+  }
+  return 0;
+}
+
+static void pending_free(){
+  for(int i=0; i < pending_count; i++){
+    pending_t * p = & pending[(pending_head + i) % pending_size];
+    if(p->tag == NULL){
+      free(p->buf);
+    }
+  }
+  free(pending);
+  pending = NULL;
+  pending_size = 0;
+  pending_head = 0;
+  pending_count = 0;
+}
 
-  size_t size = PQgetlength(res, 0, 0);
-  const char* read_data = PQgetvalue(res, 0, 0);
-  if (size > obj_size){
-    PQclear(res); // short read
+static int submit_stmt(void * tag, stmt_t stmt, char * dset_name, char * obj_name, char * buf, size_t obj_size){
+  const char * values[2] = {obj_name, buf};
+  const int lengths[2] = {(int) strlen(obj_name), (int) obj_size};
+  int ret;
+  if (PQpipelineStatus(conn) == PQ_PIPELINE_OFF && ! PQenterPipelineMode(conn)){
+    printf("PSQL error: %s\n", PQerrorMessage(conn));
     return MD_ERROR_UNKNOWN;
   }
-  memcpy(buf, read_data, size);
-  PQclear(res);
+  if (use_prepared){
+    char name[4096];
+    ret = prepare_table(dset_name);
+    if (ret != MD_SUCCESS){
+      return ret;
+    }
+    stmt_name(name, stmt, dset_name);
+    ret = PQsendQueryPrepared(conn, name, stmt_params(stmt), values, lengths, stmt_formats, 1);
+  }else{
+    char SQL[4096];
+    sprintf(SQL, stmt_sql[stmt], dset_name);
+    ret = PQsendQueryParams(conn, SQL, stmt_params(stmt), stmt_types, values, lengths, stmt_formats, 1);
+  }
+  if (! ret || ! PQpipelineSync(conn)){
+    printf("PSQL error: %s\n", PQerrorMessage(conn));
+    return MD_ERROR_UNKNOWN;
+  }
+  pending_push(tag, stmt, 1, buf, obj_size);
+  return MD_SUCCESS;
+}
+
+static int submit_write_obj(void * tag, char * dset_name, char * obj_name, char * buf, size_t obj_size){
+  return submit_stmt(tag, STMT_WRITE, dset_name, obj_name, buf, obj_size);
+}
+
+static int submit_read_obj(void * tag, char * dset_name, char * obj_name, char * buf, size_t obj_size){
+  return submit_stmt(tag, STMT_READ, dset_name, obj_name, buf, obj_size);
+}
 
-  if(obj_size == size){
+static int submit_stat_obj(void * tag, char * dset_name, char * obj_name, size_t obj_size){
+  return submit_stmt(tag, STMT_STAT, dset_name, obj_name, NULL, obj_size);
+}
+
+static int submit_delete_obj(void * tag, char * dset_name, char * obj_name){
+  return submit_stmt(tag, STMT_DELETE, dset_name, obj_name, NULL, 0);
+}
+
+// the results are returned in the order of submission
+static int poll_obj(void ** out_tag, int * out_ret){
+  while(pending_count > 0){
+    pending_t p = pending[pending_head];
+    pending_head = (pending_head + 1) % pending_size;
+    pending_count--;
+
+    int ret = MD_SUCCESS;
+    for(int i=0; i < p.statements; i++){
+      PGresult * res = PQgetResult(conn);
+      if (p.tag != NULL){
+        ret = stmt_result(p.stmt, res, p.buf, p.size);
+      }else{
+        if (! prepare_result_ok(res)){
+          printf("PSQL error (%s): %s\n", PQresStatus(PQresultStatus(res)), PQresultErrorMessage(res));
+          ret = MD_ERROR_UNKNOWN;
+        }
+        PQclear(res);
+      }
+      // the results of each statement are terminated by NULL
+      while((res = PQgetResult(conn)) != NULL){
+        PQclear(res);
+      }
+    }
+    PGresult * res = PQgetResult(conn);
+    if (PQresultStatus(res) != PGRES_PIPELINE_SYNC){
+      printf("PSQL error, expected a pipeline sync (%s)\n", PQresStatus(PQresultStatus(res)));
+    }
+    PQclear(res);
+    if (pending_count == 0){
+      PQexitPipelineMode(conn);
+    }
+    if (p.tag == NULL){
+      // otherwise, the next statement for the table prepares it again
+      if (ret == MD_SUCCESS){
+        prepared_insert(p.buf);
+      }
+      free(p.buf);
+      continue;
+    }
+    *out_tag = p.tag;
+    *out_ret = ret;
     return MD_SUCCESS;
   }
+  return MD_ERROR_FIND;
+}
+#endif
+
+// the batched operations process each run of objects of the same data set with one statement
+// the object names are passed as parameters, a statement supports up to 65535 parameters
+#define MAX_BATCH_PARAMS 32767
 
-  return MD_ERROR_UNKNOWN;
+static int dset_run_end(int count, char ** dsets, int first){
+  int end = first + 1;
+  while(end < count && end - first < MAX_BATCH_PARAMS && strcmp(dsets[end], dsets[first]) == 0){
+    end++;
+  }
+  return end;
 }
 
-static int stat_obj(char * dset_name, char * obj_name, size_t obj_size){
-  char SQL[4096];
-  PGresult * res;
-  sprintf(SQL, "SELECT octet_length(data) FROM %s WHERE obj_name = '%s'", dset_name, obj_name);
-  res = PQexec(conn, SQL);
-  if (PQresultStatus(res) != PGRES_TUPLES_OK || PQntuples(res) != 1){
+// creates the statement "<head> WHERE obj_name IN ($1, ..., $count) <tail>"
+static char * in_list_sql(char * head, char * dset_name, int count, char * tail){
+  char * SQL = malloc(strlen(head) + strlen(dset_name) + strlen(tail) + 40 + count * 8);
+  char * pos = SQL + sprintf(SQL, head, dset_name);
+  pos += sprintf(pos, " WHERE obj_name IN (");
+  for(int i=0; i < count; i++){
+    pos += sprintf(pos, "%s$%d", i == 0 ? "" : ",", i + 1);
+  }
+  sprintf(pos, ")%s", tail);
+  return SQL;
+}
+
+// sets out_ret for the objects of the run, the first column of the result contains the object name
+// for objects not contained in the result, missing_ret is set
+static void match_result(PGresult * res, char ** names, int count, int missing_ret, int * out_ret, int (*check)(PGresult * res, int row, int obj, void * arg), void * arg){
+  for(int i=0; i < count; i++){
+    out_ret[i] = missing_ret;
+  }
+  int rows = PQntuples(res);
+  for(int r=0; r < rows; r++){
+    char * name = PQgetvalue(res, r, 0);
+    for(int i=0; i < count; i++){
+      if(strcmp(name, names[i]) == 0){
+        out_ret[i] = check(res, r, i, arg);
+        break;
+      }
+    }
+  }
+}
+
+static int batch_query(char * SQL, int count, char ** names, int result_format, ExecStatusType expected, PGresult ** out_res){
+  PGresult * res = PQexecParams(conn, SQL, count, NULL, (const char * const *) names, NULL, NULL, result_format);
+  if (PQresultStatus(res) != expected){
     printf("PSQL error (%s): %s - Connection: %s SQL: %s\n", PQresStatus(PQresultStatus(res)), PQresultErrorMessage(res), PQerrorMessage(conn), SQL);
     PQclear(res);
     return MD_ERROR_UNKNOWN;
   }
-  // check the number of columns
-  char * result = PQgetvalue(res, 0, 0);
-  if ((size_t) atoll(result) != obj_size){
+  *out_res = res;
+  return MD_SUCCESS;
+}
+
+static int write_objs(int count, char ** dsets, char ** names, char ** bufs, size_t obj_size, int * out_ret){
+  for(int first=0; first < count; ){
+    int end = dset_run_end(count, dsets, first);
+    int n = end - first;
+    char * SQL = malloc(strlen(dsets[first]) + 100 + n * 24);
+    const char ** values = malloc(sizeof(char *) * 2 * n);
+    int * lengths = malloc(sizeof(int) * 2 * n);
+    int * formats = malloc(sizeof(int) * 2 * n);
+
+    char * pos = SQL + sprintf(SQL, "INSERT INTO %s(obj_name, data) VALUES", dsets[first]);
+    for(int i=0; i < n; i++){
+      pos += sprintf(pos, "%s($%d, $%d::bytea)", i == 0 ? "" : ",", 2 * i + 1, 2 * i + 2);
+      values[2 * i] = names[first + i];
+      lengths[2 * i] = 0;
+      formats[2 * i] = 0;
+      values[2 * i + 1] = bufs[first + i];
+      lengths[2 * i + 1] = (int) obj_size;
+      formats[2 * i + 1] = 1;
+    }
+    PGresult * res = PQexecParams(conn, SQL, 2 * n, NULL, values, lengths, formats, 1);
+    int ret = MD_SUCCESS;
+    if (PQresultStatus(res) != PGRES_COMMAND_OK){
+      printf("PSQL error (%s): %s - Connection: %s\n", PQresStatus(PQresultStatus(res)), PQresultErrorMessage(res), PQerrorMessage(conn));
+      ret = MD_ERROR_UNKNOWN;
+    }
     PQclear(res);
+    // the statement is atomic, i.e., all objects of the run failed
+    for(int i=first; i < end; i++){
+      out_ret[i] = ret;
+    }
+    free(SQL);
+    free(values);
+    free(lengths);
+    free(formats);
+    first = end;
+  }
+  return MD_SUCCESS;
+}
+
+typedef struct{
+  char ** bufs;
+  size_t obj_size;
+} read_arg_t;
+
+static int check_read_row(PGresult * res, int row, int obj, void * arg){
+  read_arg_t * a = (read_arg_t *) arg;
+  size_t size = PQgetlength(res, row, 1);
+  if (size != a->obj_size){
+    return MD_ERROR_UNKNOWN;
+  }
+  memcpy(a->bufs[obj], PQgetvalue(res, row, 1), size);
+  return MD_SUCCESS;
+}
+
+static int read_objs(int count, char ** dsets, char ** names, char ** bufs, size_t obj_size, int * out_ret){
+  for(int first=0; first < count; ){
+    int end = dset_run_end(count, dsets, first);
+    PGresult * res;
+    char * SQL = in_list_sql("SELECT obj_name, data FROM %s", dsets[first], end - first, "");
+    int ret = batch_query(SQL, end - first, names + first, 1, PGRES_TUPLES_OK, & res);
+    free(SQL);
+    if (ret != MD_SUCCESS){
+      for(int i=first; i < end; i++){
+        out_ret[i] = ret;
+      }
+    }else{
+      read_arg_t arg = {bufs + first, obj_size};
+      match_result(res, names + first, end - first, MD_ERROR_FIND, out_ret + first, check_read_row, & arg);
+      PQclear(res);
+    }
+    first = end;
+  }
+  return MD_SUCCESS;
+}
+
+static int check_stat_row(PGresult * res, int row, int obj, void * arg){
+  if ((size_t) atoll(PQgetvalue(res, row, 1)) != *(size_t *) arg){
     return MD_ERROR_FIND;
   }
-  PQclear(res);
   return MD_SUCCESS;
 }
 
-static int delete_obj(char * dset_name, char * obj_name){
+static int stat_objs(int count, char ** dsets, char ** names, size_t obj_size, int * out_ret){
+  for(int first=0; first < count; ){
+    int end = dset_run_end(count, dsets, first);
+    PGresult * res;
+    char * SQL = in_list_sql("SELECT obj_name, octet_length(data) FROM %s", dsets[first], end - first, "");
+    int ret = batch_query(SQL, end - first, names + first, 0, PGRES_TUPLES_OK, & res);
+    free(SQL);
+    if (ret != MD_SUCCESS){
+      for(int i=first; i < end; i++){
+        out_ret[i] = ret;
+      }
+    }else{
+      match_result(res, names + first, end - first, MD_ERROR_UNKNOWN, out_ret + first, check_stat_row, & obj_size);
+      PQclear(res);
+    }
+    first = end;
+  }
+  return MD_SUCCESS;
+}
+
+static int check_delete_row(PGresult * res, int row, int obj, void * arg){
+  return MD_SUCCESS;
+}
+
+static int delete_objs(int count, char ** dsets, char ** names, int * out_ret){
+  for(int first=0; first < count; ){
+    int end = dset_run_end(count, dsets, first);
+    PGresult * res;
+    char * SQL = in_list_sql("DELETE FROM %s", dsets[first], end - first, " RETURNING obj_name");
+    int ret = batch_query(SQL, end - first, names + first, 0, PGRES_TUPLES_OK, & res);
+    free(SQL);
+    if (ret != MD_SUCCESS){
+      for(int i=first; i < end; i++){
+        out_ret[i] = ret;
+      }
+    }else{
+      match_result(res, names + first, end - first, MD_ERROR_UNKNOWN, out_ret + first, check_delete_row, NULL);
+      PQclear(res);
+    }
+    first = end;
+  }
+  return MD_SUCCESS;
+}
+
+
+// the precreate phase streams all objects of a data set with COPY in the binary format
+static int bulk_create_objs(char * dset_name, int n, int d, int first, int last, char * buf, size_t obj_size, int * out_count){
   char SQL[4096];
-  PGresult * res;
-  sprintf(SQL, "DELETE FROM %s WHERE obj_name = '%s'", dset_name, obj_name);
-  res = PQexec(conn, SQL);
-  if (strcmp(PQcmdTuples(res), "1") != 0){
+  char obj_name[1024];
+  sprintf(SQL, "COPY %s(obj_name, data) FROM STDIN (FORMAT binary)", dset_name);
+  *out_count = 0;
+  PGresult * res = PQexec(conn, SQL);
+  if (PQresultStatus(res) != PGRES_COPY_IN){
+    printf("PSQL error (%s): %s - Connection: %s SQL: %s\n", PQresStatus(PQresultStatus(res)), PQresultErrorMessage(res), PQerrorMessage(conn), SQL);
     PQclear(res);
     return MD_ERROR_UNKNOWN;
   }
+  PQclear(res);
+
+  // the signature, flags and the length of the header extension
+  static const char header[19] = "PGCOPY\n\377\r\n\0\0\0\0\0\0\0\0\0";
+  int ok = PQputCopyData(conn, header, sizeof(header)) == 1;
+  // each tuple consists of the number of fields, followed by the length and the value of each field in network byte order
+  char * tuple = malloc(obj_size + sizeof(obj_name) + 10);
+  for(int i=first; i < last && ok; i++){
+    def_obj_name(obj_name, n, d, i);
+    uint16_t fields = htons(2);
+    uint32_t name_len = htonl((uint32_t) strlen(obj_name));
+    uint32_t data_len = htonl((uint32_t) obj_size);
+    char * pos = tuple;
+    memcpy(pos, & fields, 2);
+    pos += 2;
+    memcpy(pos, & name_len, 4);
+    pos += 4;
+    memcpy(pos, obj_name, strlen(obj_name));
+    pos += strlen(obj_name);
+    memcpy(pos, & data_len, 4);
+    pos += 4;
+    memcpy(pos, buf, obj_size);
+    pos += obj_size;
+    ok = PQputCopyData(conn, tuple, (int) (pos - tuple)) == 1;
+  }
+  free(tuple);
+  const char trailer[2] = {'\377', '\377'};
+  if (ok){
+    ok = PQputCopyData(conn, trailer, 2) == 1;
+  }
+  if (PQputCopyEnd(conn, ok ? NULL : "aborted") != 1){
+    printf("PSQL error: %s\n", PQerrorMessage(conn));
+    return MD_ERROR_UNKNOWN;
+  }
+
+  int ret = MD_SUCCESS;
+  while((res = PQgetResult(conn)) != NULL){
+    if (PQresultStatus(res) == PGRES_COMMAND_OK){
+      *out_count = atoi(PQcmdTuples(res));
+    }else{
+      printf("PSQL error (%s): %s - Connection: %s SQL: %s\n", PQresStatus(PQresultStatus(res)), PQresultErrorMessage(res), PQerrorMessage(conn), SQL);
+      ret = MD_ERROR_UNKNOWN;
+    }
+    PQclear(res);
+  }
+  return ret;
+}
+
+// all objects of a table per data set are deleted, otherwise the objects are deleted by the prefix of their name
+static int bulk_delete_objs(char * dset_name, int n, int d, int first, int last, int * out_count){
+  char SQL[4096];
+  *out_count = 0;
+  if( table_per_dset ){
+    sprintf(SQL, "DELETE FROM %s", dset_name);
+  }else{
+    sprintf(SQL, "DELETE FROM %s WHERE obj_name LIKE '%d/%d/%%'", dset_name, n, d);
+  }
+  PGresult * res = PQexec(conn, SQL);
   if (PQresultStatus(res) != PGRES_COMMAND_OK){
     printf("PSQL error (%s): %s - Connection: %s SQL: %s\n", PQresStatus(PQresultStatus(res)), PQresultErrorMessage(res), PQerrorMessage(conn), SQL);
     PQclear(res);
     return MD_ERROR_UNKNOWN;
   }
+  // the number of deleted rows
+  *out_count = atoi(PQcmdTuples(res));
   PQclear(res);
-  return MD_SUCCESS;
+  return *out_count < last - first ? MD_ERROR_FIND : MD_SUCCESS;
 }
 
 
@@ -297,5 +830,43 @@ struct md_plugin md_plugin_postgres = {
   write_obj,
   read_obj,
   stat_obj,
-  delete_obj
+  delete_obj,
+
+  NULL,
+  NULL,
+  NULL,
+  NULL,
+
+#ifdef LIBPQ_HAS_PIPELINING
+  submit_write_obj,
+  submit_read_obj,
+  submit_stat_obj,
+  submit_delete_obj,
+  poll_obj,
+#else
+  NULL,
+  NULL,
+  NULL,
+  NULL,
+  NULL,
+#endif
+
+  initialize,
+  finalize,
+
+  write_objs,
+  read_objs,
+  stat_objs,
+  delete_objs,
+
+  bulk_create_objs,
+  bulk_delete_objs,
+
+  NULL,
+
+  NULL,
+  NULL,
+
+  NULL,
+  NULL
 };
@@ -21,10 +21,14 @@
 #include <stdio.h>
 #include <fcntl.h>
 #include <string.h>
+#include <stdlib.h>
+#include <sys/select.h>
+#include <dirent.h>
 
 #include <libs3.h>
 
 #include <plugins/md-s3.h>
+#include <md_util.h>
 
 static int bucket_per_set = 0;
 static char * access_key = NULL;
@@ -36,9 +40,17 @@ static char * locationConstraint = NULL;
 static int dont_suffix = 0;
 static int s3_compatible = 0;
 static int use_ssl = 0;
+static int reuse_connections = 0;
+static int count_connections = 0;
 static S3Protocol s3_protocol = S3ProtocolHTTP;
 
 static S3BucketContext bucket_context = {NULL};
+S3BucketContext * getBucket(char * bucket_name);
+static void releaseBucket(char * bucket_name);
+static void freeBuckets();
+
+// asynchronous requests are driven by the request context
+static S3RequestContext * request_context = NULL;
 
 static option_help options [] = {
   {'b', "bucket-per-set", "Use one bucket to map a set, otherwise only one bucket is used.", OPTION_FLAG, 'd', & bucket_per_set},
@@ -46,6 +58,8 @@ static option_help options [] = {
   {'p', "dont-suffix-bucket", "If not selected, then a hash will be added to the bucket name to increase uniqueness.", OPTION_FLAG, 'd', & dont_suffix },
   {'c', "s3-compatible", "to be selected when using S3 compatible storage", OPTION_FLAG, 'd', & s3_compatible },
   {'l', "use-ssl", "used to specify that SSL is needed for the connection", OPTION_FLAG, 'd', & use_ssl },
+  {'r', "reuse-connections", "Run all requests through a persistent request context that keeps the connections open.", OPTION_FLAG, 'd', & reuse_connections },
+  {'C', "count-connections", "Count the connections to the host established per phase, the sockets are scanned at the start and end of each phase, i.e., connections closed within the phase are not counted (use -r).", OPTION_FLAG, 'd', & count_connections },
   {'H', "host", "The host optionally followed by:port.", OPTION_OPTIONAL_ARGUMENT, 's', & host},
   {'s', "secret-key", "The secret key.", OPTION_REQUIRED_ARGUMENT, 'H', & secret_key},
   {'a', "access-key", "The access key.", OPTION_REQUIRED_ARGUMENT, 'H', & access_key},
@@ -93,16 +107,21 @@ static int initialize(){
 }
 
 static int finalize(){
+  if (request_context != NULL){
+    S3_destroy_request_context(request_context);
+    request_context = NULL;
+  }
+  freeBuckets();
   S3_deinitialize();
   return MD_SUCCESS;
 }
 
 static int def_dset_name(char * out_name, int n, int d){
   // S3_MAX_BUCKET_NAME_SIZE
+  char * pos = format_str(out_name, bucket_prefix);
   if (bucket_per_set){
-    sprintf(out_name, "%sx%dx%d", bucket_prefix, n, d);
-  }else{
-    sprintf(out_name, "%s", bucket_prefix);
+    pos = format_int(format_str(pos, "x"), n);
+    format_int(format_str(pos, "x"), d);
   }
   return MD_SUCCESS;
 }
@@ -110,37 +129,75 @@ static int def_dset_name(char * out_name, int n, int d){
 static int def_obj_name(char * out_name, int n, int d, int i){
   // S3_MAX_KEY_SIZE
   if (bucket_per_set){
-    sprintf(out_name, "%d", i);
+    format_int(out_name, i);
   }else{
-    sprintf(out_name, "%d_%d_%d", n, d, i);
+    char * pos = format_int(out_name, n);
+    pos = format_int(format_str(pos, "_"), d);
+    format_int(format_str(pos, "_"), i);
   }
   return MD_SUCCESS;
 }
 
 
-static S3Status s3status = S3StatusInterrupted;
-static S3ErrorDetails s3error = {NULL};
+// the state of a single request, the callbacks store the status in it
+typedef struct s3_request_t{
+  S3Status status;
+  char message[1024];
+  // the data to put or get
+  char * buf;
+  int64_t size;
+  // the expected size of a head request
+  size_t obj_size;
+  int put; // the errors of a put are ignored with -c, see write_obj()
+  // asynchronous requests
+  void * tag;
+  struct s3_request_t * next;
+} s3_request_t;
+
+static void init_request(s3_request_t * r, void * tag){
+  r->status = S3StatusInterrupted;
+  r->message[0] = 0;
+  r->put = 0;
+  r->tag = tag;
+  r->next = NULL;
+}
+
+static int check_request(s3_request_t * r){
+  if (r->status != S3StatusOK){
+    printf("Error \"%s\": %s\n", S3_get_status_name(r->status), r->message);
+    return MD_ERROR_UNKNOWN;
+  }
+  return MD_SUCCESS;
+}
+
+// the completed asynchronous requests, see poll_obj()
+static s3_request_t * completed = NULL;
+static int outstanding = 0;
 
 static S3Status responsePropertiesCallback(const S3ResponseProperties *properties, void *callbackData){
-  s3status = S3StatusOK;
-  return s3status;
+  s3_request_t * r = (s3_request_t *) callbackData;
+  r->status = S3StatusOK;
+  return r->status;
 }
 
 static void responseCompleteCallback(S3Status status, const S3ErrorDetails *error, void *callbackData) {
-  s3status = status;
-  if (error == NULL){
-    s3error.message = NULL;
-  }else{
-    s3error = *error;
+  s3_request_t * r = (s3_request_t *) callbackData;
+  r->status = status;
+  if (error != NULL && error->message != NULL){
+    snprintf(r->message, sizeof(r->message), "%s - %s", error->message, error->furtherDetails ? error->furtherDetails : "");
+  }
+  if (r->tag != NULL){
+    r->next = completed;
+    completed = r;
   }
   return;
 }
 
-#define CHECK_ERROR if (s3status != S3StatusOK){ printf("Error \"%s\": %s - %s\n", S3_get_status_name(s3status), s3error.message, s3error.furtherDetails); return MD_ERROR_UNKNOWN; }
-
 static S3ResponseHandler responseHandler = {  &responsePropertiesCallback, &responseCompleteCallback };
 
+
 static int prepare_global(){
+  s3_request_t r;
   if (use_ssl){
     s3_protocol = S3ProtocolHTTPS;
   }
@@ -148,76 +205,93 @@ static int prepare_global(){
   if (! bucket_per_set){
     // check if the bucket exists, otherwise create it
 
-    S3_test_bucket(s3_protocol, S3UriStylePath, access_key, secret_key, NULL, bucket_prefix, S3CannedAclPrivate, locationConstraint, NULL,  & responseHandler, NULL);
-    if (s3status != S3StatusErrorNoSuchBucket){
+    init_request(& r, NULL);
+    S3_test_bucket(s3_protocol, S3UriStylePath, access_key, secret_key, NULL, bucket_prefix, S3CannedAclPrivate, locationConstraint, NULL,  & responseHandler, & r);
+    if (r.status != S3StatusErrorNoSuchBucket){
        printf("Error, the bucket %s already exists\n", bucket_prefix);
        return MD_ERROR_UNKNOWN;
     }
-    S3_create_bucket(s3_protocol, access_key, secret_key, NULL, bucket_prefix, S3CannedAclPrivate, locationConstraint, NULL,  & responseHandler, NULL);
-    CHECK_ERROR
-    return MD_SUCCESS;
+    init_request(& r, NULL);
+    S3_create_bucket(s3_protocol, access_key, secret_key, NULL, bucket_prefix, S3CannedAclPrivate, locationConstraint, NULL,  & responseHandler, & r);
+    return check_request(& r);
   }
 
   return MD_NOOP;
 }
 
 static int purge_global(){
+  s3_request_t r;
   if (use_ssl){
     s3_protocol = S3ProtocolHTTPS;
   } 
   if (! bucket_per_set){
-    S3_delete_bucket(s3_protocol, S3UriStylePath, access_key, secret_key, NULL, bucket_prefix, NULL,  & responseHandler, NULL);
-    CHECK_ERROR
-    return MD_SUCCESS;
+    init_request(& r, NULL);
+    S3_delete_bucket(s3_protocol, S3UriStylePath, access_key, secret_key, NULL, bucket_prefix, NULL,  & responseHandler, & r);
+    return check_request(& r);
   }
   return MD_NOOP;
 }
 
 
 static int create_dset(char * name){
+  s3_request_t r;
   if (use_ssl){
     s3_protocol = S3ProtocolHTTPS;
   }
   if (bucket_per_set){
-    S3_create_bucket(s3_protocol, access_key, secret_key, NULL, name, S3CannedAclPrivate, locationConstraint, NULL,  & responseHandler, NULL);
-    CHECK_ERROR
-    return MD_SUCCESS;
+    init_request(& r, NULL);
+    S3_create_bucket(s3_protocol, access_key, secret_key, NULL, name, S3CannedAclPrivate, locationConstraint, NULL,  & responseHandler, & r);
+    getBucket(name);
+    return check_request(& r);
   }else{
     return MD_NOOP;
   }
 }
 
 static int rm_dset(char * name){
+  s3_request_t r;
     if (use_ssl){
     s3_protocol = S3ProtocolHTTPS;
   }
     if (bucket_per_set){
-    S3_delete_bucket(s3_protocol, S3UriStylePath, access_key, secret_key, NULL, name, NULL,  & responseHandler, NULL);
-    CHECK_ERROR
-    return MD_SUCCESS;
+    init_request(& r, NULL);
+    S3_delete_bucket(s3_protocol, S3UriStylePath, access_key, secret_key, NULL, name, NULL,  & responseHandler, & r);
+    releaseBucket(name);
+    return check_request(& r);
   }else{
     return MD_NOOP;
   }
 }
 
-S3BucketContext * getBucket(char * objname){
-  if (bucket_per_set){
-    // choose the set bucket
-    bucket_context.bucketName = objname;
-    return & bucket_context;
-  }else{
+// with -b, each bucket has its own context, they are created with the bucket or on first use
+static cache_t buckets;
+
+S3BucketContext * getBucket(char * bucket_name){
+  if (! bucket_per_set){
     // choose the global bucket
     return & bucket_context;
   }
+  cache_entry_t * e = cache_find(& buckets, bucket_name);
+  if (e != NULL){
+    return (S3BucketContext *) e->value;
+  }
+  S3BucketContext * context = malloc(sizeof(S3BucketContext));
+  *context = bucket_context;
+  e = cache_insert(& buckets, bucket_name, context);
+  context->bucketName = e->key;
+  return context;
 }
 
-struct data_handling{
-  char * buf;
-  int64_t size;
-};
+static void releaseBucket(char * bucket_name){
+  free(cache_remove(& buckets, bucket_name));
+}
+
+static void freeBuckets(){
+  cache_free(& buckets, free);
+}
 
 static int putObjectDataCallback(int bufferSize, char *buffer, void *callbackData){
-  struct data_handling * dh = (struct data_handling *) callbackData;
+  s3_request_t * dh = (s3_request_t *) callbackData;
   const int64_t size = dh->size > bufferSize ? bufferSize : dh->size;
   memcpy(buffer, dh->buf, size);
   dh->buf += size;
@@ -228,19 +302,8 @@ static int putObjectDataCallback(int bufferSize, char *buffer, void *callbackDat
 
 static S3PutObjectHandler putObjectHandler = { {  &responsePropertiesCallback, &responseCompleteCallback }, & putObjectDataCallback };
 
-static int write_obj(char * bucket_name, char * obj_name, char * buf, size_t obj_size){
-  struct data_handling dh = { .buf = buf, .size = obj_size };
-  S3BucketContext * bucket = getBucket(bucket_name);
-  S3_put_object(bucket, obj_name, obj_size, NULL, NULL, &putObjectHandler, & dh);
-  
-    if (! s3_compatible){
-    CHECK_ERROR
-   }
-  return MD_SUCCESS;
-}
-
 static S3Status getObjectDataCallback(int bufferSize, const char *buffer,  void *callbackData){
-  struct data_handling * dh = (struct data_handling *) callbackData;
+  s3_request_t * dh = (s3_request_t *) callbackData;
   const int64_t size = dh->size > bufferSize ? bufferSize : dh->size;
   memcpy(dh->buf, buffer, size);
   dh->buf += size;
@@ -251,47 +314,304 @@ static S3Status getObjectDataCallback(int bufferSize, const char *buffer,  void
 
 static S3GetObjectHandler getObjectHandler = { {  &responsePropertiesCallback, &responseCompleteCallback }, & getObjectDataCallback };
 
-static int read_obj(char * bucket_name, char * obj_name, char * buf, size_t obj_size){
-  S3BucketContext * bucket = getBucket(bucket_name);
-  struct data_handling dh = { .buf = buf, .size = obj_size };
-  S3_get_object(bucket, obj_name, NULL, 0, obj_size, NULL, &getObjectHandler, & dh);
-  CHECK_ERROR
-
-  return MD_SUCCESS;
-}
-
 static S3Status statResponsePropertiesCallback(const S3ResponseProperties *properties, void *callbackData){
   // check the size
-  size_t * obj_size = (size_t*) callbackData;
-  if(*obj_size != properties->contentLength){
-    //printf("%lu %lu\n",*obj_size, properties->contentLength);
-     s3status = -1;
-    return s3status;
+  s3_request_t * r = (s3_request_t *) callbackData;
+  if(r->obj_size != properties->contentLength){
+    //printf("%lu %lu\n", r->obj_size, properties->contentLength);
+    r->status = -1;
+    return r->status;
   }
-  s3status = S3StatusOK;
-  return s3status;
+  r->status = S3StatusOK;
+  return r->status;
 }
 
 static S3ResponseHandler statResponseHandler = {  &statResponsePropertiesCallback, &responseCompleteCallback };
 
+// the requests are started with the given request context, NULL performs them synchronously
+static void put_request(S3RequestContext * ctx, s3_request_t * r, char * bucket_name, char * obj_name, char * buf, size_t obj_size){
+  r->buf = buf;
+  r->size = obj_size;
+  r->put = 1;
+  S3_put_object(getBucket(bucket_name), obj_name, obj_size, NULL, ctx, &putObjectHandler, r);
+}
 
-static int stat_obj(char * bucket_name, char * obj_name, size_t obj_size){
+static void get_request(S3RequestContext * ctx, s3_request_t * r, char * bucket_name, char * obj_name, char * buf, size_t obj_size){
+  r->buf = buf;
+  r->size = obj_size;
+  S3_get_object(getBucket(bucket_name), obj_name, NULL, 0, obj_size, ctx, &getObjectHandler, r);
+}
+
+static void head_request(S3RequestContext * ctx, s3_request_t * r, char * bucket_name, char * obj_name, size_t obj_size){
   // how to ? Should use HEAD request, S3_head_object (?) or use S3_get_object with size = 1, offset = 0 ?
-  S3BucketContext * bucket = getBucket(bucket_name);
-  S3_head_object(bucket, obj_name, NULL, & statResponseHandler, & obj_size);
-  CHECK_ERROR
+  r->obj_size = obj_size;
+  S3_head_object(getBucket(bucket_name), obj_name, ctx, & statResponseHandler, r);
+}
+
+static void delete_request(S3RequestContext * ctx, s3_request_t * r, char * bucket_name, char * obj_name){
+  S3_delete_object(getBucket(bucket_name), obj_name, ctx, & responseHandler, r);
+}
+
+/*
+ Connection setups are counted by the sockets of the process that are connected to the port of the host and were not open during the previous scan.
+ libs3 does not expose its connections, thus /proc/self/fd is scanned by connection_count() at the phase boundaries only.
+ The sockets of other ports, e.g., of MPI, are excluded by their remote port in /proc/net/tcp.
+ */
+#define MAX_SOCKETS 1024
+
+static unsigned long sockets[MAX_SOCKETS];
+static int socket_count = 0;
+static uint64_t connections = 0;
+
+static int host_port(){
+  char * port = host == NULL ? NULL : strrchr(host, ':');
+  if (port != NULL){
+    return atoi(port + 1);
+  }
+  return use_ssl ? 443 : 80;
+}
+
+// add the inodes of the TCP sockets with the remote port from the given table
+static void scan_tcp(const char * table, int port, unsigned long * inodes, int * count){
+  char line[512];
+  FILE * f = fopen(table, "r");
+  if (f == NULL){
+    return;
+  }
+  // skip the header
+  char * ret = fgets(line, sizeof(line), f);
+  while(ret != NULL && fgets(line, sizeof(line), f) != NULL && *count < MAX_SOCKETS){
+    unsigned int remote_port;
+    unsigned long inode;
+    // sl local_address rem_address st tx_queue:rx_queue tr:tm->when retrnsmt uid timeout inode
+    if (sscanf(line, "%*s %*s %*[0-9A-Fa-f]:%x %*s %*s %*s %*s %*s %*s %lu", & remote_port, & inode) != 2){
+      continue;
+    }
+    if ((int) remote_port == port){
+      inodes[(*count)++] = inode;
+    }
+  }
+  fclose(f);
+}
+
+static void scan_sockets(){
+  unsigned long host_sockets[MAX_SOCKETS];
+  int host_count = 0;
+  unsigned long current[MAX_SOCKETS];
+  int current_count = 0;
+  char path[64];
+  char link[64];
+  int port = host_port();
+  scan_tcp("/proc/net/tcp", port, host_sockets, & host_count);
+  scan_tcp("/proc/net/tcp6", port, host_sockets, & host_count);
+  DIR * dir = opendir("/proc/self/fd");
+  if (dir == NULL){
+    return;
+  }
+  struct dirent * e;
+  while((e = readdir(dir)) != NULL && current_count < MAX_SOCKETS){
+    unsigned long inode;
+    snprintf(path, sizeof(path), "/proc/self/fd/%.32s", e->d_name);
+    ssize_t len = readlink(path, link, sizeof(link) - 1);
+    if (len <= 0){
+      continue;
+    }
+    link[len] = 0;
+    if (sscanf(link, "socket:[%lu]", & inode) != 1){
+      continue;
+    }
+    int to_host = 0;
+    for(int i=0; i < host_count && ! to_host; i++){
+      to_host = host_sockets[i] == inode;
+    }
+    if (! to_host){
+      continue;
+    }
+    int known = 0;
+    for(int i=0; i < socket_count && ! known; i++){
+      known = sockets[i] == inode;
+    }
+    connections += ! known;
+    current[current_count++] = inode;
+  }
+  closedir(dir);
+  memcpy(sockets, current, sizeof(unsigned long) * current_count);
+  socket_count = current_count;
+}
+
+static int connection_count(uint64_t * out_count){
+  if (! count_connections){
+    return MD_NOOP;
+  }
+  scan_sockets();
+  *out_count = connections;
   return MD_SUCCESS;
 }
 
+static int create_request_context(){
+  if (request_context == NULL){
+    S3Status status = S3_create_request_context(& request_context);
+    if (status != S3StatusOK){
+      printf("Error creating the request context: %s\n", S3_get_status_name(status));
+      return MD_ERROR_UNKNOWN;
+    }
+  }
+  return MD_SUCCESS;
+}
+
+// with -r, synchronous requests are run by the persistent request context, too
+static S3RequestContext * sync_context(){
+  if (reuse_connections && create_request_context() == MD_SUCCESS){
+    return request_context;
+  }
+  return NULL;
+}
+
+static int finish_sync(S3RequestContext * ctx, s3_request_t * r){
+  if (ctx != NULL){
+    S3Status status = S3_runall_request_context(ctx);
+    if (status != S3StatusOK && r->status == S3StatusOK){
+      r->status = status;
+    }
+  }
+  return check_request(r);
+}
+
+static int write_obj(char * bucket_name, char * obj_name, char * buf, size_t obj_size){
+  s3_request_t r;
+  S3RequestContext * ctx = sync_context();
+  init_request(& r, NULL);
+  put_request(ctx, & r, bucket_name, obj_name, buf, obj_size);
+  int ret = finish_sync(ctx, & r);
+  
+    if (! s3_compatible){
+    return ret;
+   }
+  return MD_SUCCESS;
+}
+
+static int read_obj(char * bucket_name, char * obj_name, char * buf, size_t obj_size){
+  s3_request_t r;
+  S3RequestContext * ctx = sync_context();
+  init_request(& r, NULL);
+  get_request(ctx, & r, bucket_name, obj_name, buf, obj_size);
+  return finish_sync(ctx, & r);
+}
+
+static int stat_obj(char * bucket_name, char * obj_name, size_t obj_size){
+  s3_request_t r;
+  S3RequestContext * ctx = sync_context();
+  init_request(& r, NULL);
+  head_request(ctx, & r, bucket_name, obj_name, obj_size);
+  return finish_sync(ctx, & r);
+}
+
 static int delete_obj(char * bucket_name, char * obj_name){
-  S3BucketContext * bucket = getBucket(bucket_name);
+  s3_request_t r;
+  S3RequestContext * ctx = sync_context();
+  init_request(& r, NULL);
+  delete_request(ctx, & r, bucket_name, obj_name);
+  return finish_sync(ctx, & r);
+}
+
+/*
+ With --queue-depth, the requests are added to a libs3 request context and run concurrently.
+ The request context is driven by poll_obj(), which waits for activity on the connections.
+ */
+static s3_request_t * new_request(void * tag){
+  if (create_request_context() != MD_SUCCESS){
+    return NULL;
+  }
+  s3_request_t * r = malloc(sizeof(s3_request_t));
+  init_request(r, tag);
+  outstanding++;
+  return r;
+}
 
-  S3_delete_object(bucket, obj_name, NULL, & responseHandler, NULL);
-  CHECK_ERROR
+static int submit_write_obj(void * tag, char * bucket_name, char * obj_name, char * buf, size_t obj_size){
+  s3_request_t * r = new_request(tag);
+  if (r == NULL){
+    return MD_ERROR_UNKNOWN;
+  }
+  put_request(request_context, r, bucket_name, obj_name, buf, obj_size);
   return MD_SUCCESS;
 }
 
+static int submit_read_obj(void * tag, char * bucket_name, char * obj_name, char * buf, size_t obj_size){
+  s3_request_t * r = new_request(tag);
+  if (r == NULL){
+    return MD_ERROR_UNKNOWN;
+  }
+  get_request(request_context, r, bucket_name, obj_name, buf, obj_size);
+  return MD_SUCCESS;
+}
 
+static int submit_stat_obj(void * tag, char * bucket_name, char * obj_name, size_t obj_size){
+  s3_request_t * r = new_request(tag);
+  if (r == NULL){
+    return MD_ERROR_UNKNOWN;
+  }
+  head_request(request_context, r, bucket_name, obj_name, obj_size);
+  return MD_SUCCESS;
+}
+
+static int submit_delete_obj(void * tag, char * bucket_name, char * obj_name){
+  s3_request_t * r = new_request(tag);
+  if (r == NULL){
+    return MD_ERROR_UNKNOWN;
+  }
+  delete_request(request_context, r, bucket_name, obj_name);
+  return MD_SUCCESS;
+}
+
+// block until there is activity on a connection of the request context or its timeout expired
+static void wait_for_requests(){
+  fd_set read_fds;
+  fd_set write_fds;
+  fd_set except_fds;
+  int max_fd = -1;
+  FD_ZERO(& read_fds);
+  FD_ZERO(& write_fds);
+  FD_ZERO(& except_fds);
+  S3_get_request_context_fdsets(request_context, & read_fds, & write_fds, & except_fds, & max_fd);
+  int64_t timeout = S3_get_request_context_timeout(request_context);
+  if (timeout < 0 || timeout > 100){
+    timeout = 100;
+  }
+  if (max_fd == -1){
+    // no connection is established yet
+    timeout = 1;
+  }
+  struct timeval tv = { timeout / 1000, (timeout % 1000) * 1000 };
+  select(max_fd + 1, & read_fds, & write_fds, & except_fds, & tv);
+}
+
+static int poll_obj(void ** out_tag, int * out_ret){
+  while(completed == NULL){
+    if (outstanding == 0){
+      return MD_ERROR_FIND;
+    }
+    int remaining;
+    S3Status status = S3_runonce_request_context(request_context, & remaining);
+    if (status != S3StatusOK){
+      printf("Error running the requests: %s\n", S3_get_status_name(status));
+      return MD_ERROR_UNKNOWN;
+    }
+    if (completed == NULL){
+      wait_for_requests();
+    }
+  }
+  s3_request_t * r = completed;
+  completed = r->next;
+  outstanding--;
+  *out_tag = r->tag;
+  *out_ret = check_request(r);
+  if (r->put && s3_compatible){
+    *out_ret = MD_SUCCESS;
+  }
+  free(r);
+  return MD_SUCCESS;
+}
 
 
 struct md_plugin md_plugin_s3 = {
@@ -310,5 +630,35 @@ struct md_plugin md_plugin_s3 = {
   write_obj,
   read_obj,
   stat_obj,
-  delete_obj
-};
+  delete_obj,
+
+  NULL,
+  NULL,
+  NULL,
+  NULL,
+
+  submit_write_obj,
+  submit_read_obj,
+  submit_stat_obj,
+  submit_delete_obj,
+  poll_obj,
+
+  NULL,
+  NULL,
+
+  NULL,
+  NULL,
+  NULL,
+  NULL,
+
+  NULL,
+  NULL,
+
+  connection_count,
+
+  NULL,
+  NULL,
+
+  NULL,
+  NULL
+};
\ No newline at end of file
@@ -0,0 +1,87 @@
+#!/usr/bin/env python3
+
+# Reader for the binary latency files of md-workbench (--latency-format=binary or mpiio)
+# The file is mapped into memory, the columns are returned as numpy arrays (or memoryviews if numpy is not installed) without copying the data.
+#
+# Usage: read-latency-file.py <file> [<operation>]
+#   without operation: print the header and a summary of each operation
+#   with operation: print the timings of the operation as CSV (time,runtime), e.g., for analyze-stats-file.R
+
+import mmap
+import struct
+import sys
+
+try:
+  import numpy
+except ImportError:
+  numpy = None
+
+# see latency_file_header_t and latency_file_section_t in md-workbench.c, the data is in native byte order
+HEADER = struct.Struct("=8sIIIIifQII16s")
+SECTION = struct.Struct("=16sQQ")
+MAGIC = b"MDWBLAT\0"
+# see latency_shared_header_t and latency_shared_index_t
+SHARED_HEADER = struct.Struct("=8sIIifQII16s")
+SHARED_INDEX = struct.Struct("=QQ")
+SHARED_MAGIC = b"MDWBSHR\0"
+
+def column(mm, offset, count):
+  if numpy is not None:
+    return numpy.frombuffer(mm, dtype=numpy.float32, count=count, offset=offset)
+  return memoryview(mm)[offset:offset + 4 * count].cast("f")
+
+# the records of the shared file contain the start time and the runtime
+def records(mm, offset, count):
+  if numpy is not None:
+    data = numpy.frombuffer(mm, dtype=numpy.float32, count=2 * count, offset=offset).reshape(count, 2)
+    return (data[:, 0], data[:, 1])
+  data = memoryview(mm)[offset:offset + 8 * count].cast("f")
+  return (data[0::2], data[1::2])
+
+def read_shared_file(mm):
+  (magic, version, ranks, iteration, waiting_factor, object_size, dset_count, reserved, name) = SHARED_HEADER.unpack_from(mm, 0)
+  header = {"ranks" : ranks, "all_ranks" : 1, "iteration" : iteration, "waiting_factor" : waiting_factor, "object_size" : object_size, "dset_count" : dset_count}
+  # the records of the processes are stored consecutively
+  index = [SHARED_INDEX.unpack_from(mm, SHARED_HEADER.size + i * SHARED_INDEX.size) for i in range(ranks)]
+  header["index"] = index
+  count = sum(c for (c, offset) in index)
+  start = SHARED_HEADER.size + ranks * SHARED_INDEX.size
+  return (header, {name.rstrip(b"\0").decode() : records(mm, start, count)})
+
+def read_latency_file(filename):
+  with open(filename, "rb") as f:
+    mm = mmap.mmap(f.fileno(), 0, access=mmap.ACCESS_READ)
+  if mm[0:8] == SHARED_MAGIC:
+    return read_shared_file(mm)
+  (magic, version, section_count, ranks, all_ranks, iteration, waiting_factor, object_size, dset_count, reserved, phase) = HEADER.unpack_from(mm, 0)
+  if magic != MAGIC or version != 1:
+    raise ValueError("%s is not a md-workbench latency file" % filename)
+  header = {"phase" : phase.rstrip(b"\0").decode(), "ranks" : ranks, "all_ranks" : all_ranks, "iteration" : iteration, "waiting_factor" : waiting_factor, "object_size" : object_size, "dset_count" : dset_count}
+  sections = {}
+  for i in range(section_count):
+    (name, count, offset) = SECTION.unpack_from(mm, HEADER.size + i * SECTION.size)
+    sections[name.rstrip(b"\0").decode()] = (column(mm, offset, count), column(mm, offset + 4 * count, count))
+  return (header, sections)
+
+def main():
+  if len(sys.argv) < 2:
+    print("Synopsis: %s <file> [<operation>]" % sys.argv[0])
+    sys.exit(1)
+  (header, sections) = read_latency_file(sys.argv[1])
+  if len(sys.argv) > 2:
+    (time, runtime) = sections[sys.argv[2]]
+    out = sys.stdout
+    out.write("time,runtime\n")
+    for i in range(len(time)):
+      out.write("%.7f,%.4e\n" % (time[i], runtime[i]))
+    return
+  print(header)
+  for name, (time, runtime) in sections.items():
+    count = len(runtime)
+    if count == 0:
+      print("%s: 0 operations" % name)
+      continue
+    print("%s: %d operations min: %.4e max: %.4e mean: %.4e" % (name, count, min(runtime), max(runtime), sum(runtime) / count))
+
+if __name__ == "__main__":
+  main()
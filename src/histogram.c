@@ -0,0 +1,105 @@
+// This file is part of MD-REAL-IO.
+//
+// MD-REAL-IO is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// MD-REAL-IO is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with MD-REAL-IO.  If not, see <http://www.gnu.org/licenses/>.
+//
+// Author: Julian Kunkel
+
+#include <string.h>
+#include <math.h>
+
+#include <md_histogram.h>
+
+#define SUB_BUCKETS (1 << HISTOGRAM_SUB_BUCKET_BITS)
+
+static int histogram_index(uint64_t ns){
+  if(ns < SUB_BUCKETS){
+    return (int) ns;
+  }
+  if(ns >> HISTOGRAM_MAX_EXPONENT){
+    return HISTOGRAM_BUCKETS - 1;
+  }
+  // the position of the highest bit determines the magnitude, the following bits the sub bucket
+  int shift = 63 - __builtin_clzll(ns) - HISTOGRAM_SUB_BUCKET_BITS;
+  return ((shift + 1) << HISTOGRAM_SUB_BUCKET_BITS) + (int) ((ns >> shift) & (SUB_BUCKETS - 1));
+}
+
+// the value in the middle of the bucket in ns
+static double histogram_bucket_value(int index){
+  if(index < SUB_BUCKETS){
+    return index;
+  }
+  int shift = (index >> HISTOGRAM_SUB_BUCKET_BITS) - 1;
+  uint64_t low = ((uint64_t) (SUB_BUCKETS + (index & (SUB_BUCKETS - 1)))) << shift;
+  return low + ((1llu << shift) - 1) / 2.0;
+}
+
+void histogram_init(histogram_t * h){
+  memset(h, 0, sizeof(histogram_t));
+}
+
+void histogram_add(histogram_t * h, double value){
+  if(value < 0){
+    value = 0;
+  }
+  if(h->count == 0 || value < h->min){
+    h->min = value;
+  }
+  if(value > h->max){
+    h->max = value;
+  }
+  h->count++;
+  h->buckets[histogram_index((uint64_t) (value * 1e9 + 0.5))]++;
+}
+
+void histogram_merge(histogram_t * h, const histogram_t * other){
+  if(other->count == 0){
+    return;
+  }
+  if(h->count == 0 || other->min < h->min){
+    h->min = other->min;
+  }
+  if(other->max > h->max){
+    h->max = other->max;
+  }
+  h->count += other->count;
+  for(int i=0; i < HISTOGRAM_BUCKETS; i++){
+    h->buckets[i] += other->buckets[i];
+  }
+}
+
+double histogram_quantile(const histogram_t * h, double quantile){
+  if(h->count == 0){
+    return 0;
+  }
+  uint64_t rank = (uint64_t) ceil(quantile * h->count);
+  if(rank < 1){
+    rank = 1;
+  }
+  uint64_t sum = 0;
+  for(int i=0; i < HISTOGRAM_BUCKETS; i++){
+    sum += h->buckets[i];
+    if(sum >= rank){
+      double value = histogram_bucket_value(i) / 1e9;
+      // the exact extremes are known, the bucket value may exceed them
+      if(value < h->min){
+        return h->min;
+      }
+      if(value > h->max){
+        return h->max;
+      }
+      return value;
+    }
+  }
+  return h->max;
+}
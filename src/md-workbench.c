@@ -24,15 +24,19 @@
 #include <errno.h>
 #include <string.h>
 #include <stdlib.h>
+#include <limits.h>
 #include <math.h>
+#include <pthread.h>
 
 #include <md_util.h>
 #include <md_option.h>
+#include <md_histogram.h>
 
 #include <plugins/md-plugin.h>
 
 #include <plugins/md-dummy.h>
 #include <plugins/md-posix.h>
+#include <plugins/md-posix-uring.h>
 #include <plugins/md-postgres.h>
 #include <plugins/md-mongo.h>
 #include <plugins/md-s3.h>
@@ -41,6 +45,9 @@
 struct md_plugin * md_plugin_list[] = {
 & md_plugin_dummy,
 & md_plugin_posix,
+#ifdef MD_PLUGIN_POSIX_URING
+& md_plugin_posix_uring,
+#endif
 #ifdef MD_PLUGIN_MPIIO
 & md_plugin_mpi,
 #endif
@@ -89,6 +96,19 @@ typedef struct{
   float max;
 } time_statistics_t;
 
+// the operation types for which latencies are recorded
+typedef enum{
+  OP_CREATE = 0,
+  OP_READ,
+  OP_STAT,
+  OP_DELETE,
+  OP_SYNC, // making a written or deleted object durable, see sync_obj in md-plugin.h
+  OP_TYPES
+} op_type_t;
+
+// the object sizes with --size-dist are accounted in power-of-two ranges, see size_bucket()
+#define SIZE_BUCKETS 33
+
 // statistics for running a single phase
 typedef struct{ // NOTE: if this type is changed, adjust end_phase() !!!
   double t; // maximum time
@@ -103,23 +123,55 @@ typedef struct{ // NOTE: if this type is changed, adjust end_phase() !!!
   op_stat_t obj_read;
   op_stat_t obj_stat;
   op_stat_t obj_delete;
+  op_stat_t obj_sync;
+  op_stat_t obj_verify; // the read objects that were verified with --verify
 
-  // time measurements individual runs
+  // time measurements individual runs, only kept if latency files are written
   uint64_t repeats;
   time_result_t * time_create;
   time_result_t * time_read;
   time_result_t * time_stat;
   time_result_t * time_delete;
+  time_result_t * time_sync; // the sync of the object written at the same position
 
   time_statistics_t stats_create;
   time_statistics_t stats_read;
   time_statistics_t stats_stat;
   time_statistics_t stats_delete;
+  time_statistics_t stats_sync;
+
+  // latency histogram per operation type, indexed by op_type_t
+  // with --target-rate, these contain the response time since the scheduled start and OP_TYPES histograms with the service time follow
+  histogram_t * hist;
+  time_statistics_t stats_service[OP_TYPES];
 
   // the maximum time for any single operation
   double max_op_time;
   timer phase_start_timer;
   int stonewall_iterations;
+  // the time to collect the statistics at the end of the phase
+  double t_aggregate;
+
+  // bulk operations with --bulk, their objects are counted in obj_create / obj_delete but they are not part of the latency statistics
+  int bulk_ops;
+  double bulk_time; // the sum of their runtimes
+  double bulk_max_time;
+
+  // the connections established by the plugin during the phase, negative if the plugin does not count them
+  int connections;
+
+  // the eviction of the objects before they are read with --cold-cache-reads, not part of the latency statistics
+  int evict_ops;
+  double evict_time;
+
+  // generating and checking the pattern of the objects with --verify, not part of the latency statistics
+  int verify_ops;
+  double verify_time;
+
+  // the operations per range of the object size with --size-dist, indexed by op_type_t and size_bucket()
+  int size_ops[OP_TYPES][SIZE_BUCKETS];
+  double size_time[OP_TYPES][SIZE_BUCKETS]; // the sum of their runtimes
+  double size_max_time[OP_TYPES][SIZE_BUCKETS];
 } phase_stat_t;
 
 #define CHECK_MPI_RET(ret) if (ret != MPI_SUCCESS){ printf("Unexpected error in MPI on Line %d\n", __LINE__);}
@@ -143,6 +195,7 @@ struct benchmark_options{
 
   char * latency_file_prefix;
   int latency_keep_all;
+  char * latency_format;
 
   int phase_cleanup;
   int phase_precreate;
@@ -167,12 +220,65 @@ struct benchmark_options{
   int adaptive_waiting_mode;
 
   uint64_t start_item_number;
+  int queue_depth;
+  int threads;
+
+  float target_rate;
+  int target_rate_per_rank;
+  char * arrival;
+
+  float report_interval;
+
+  int batch_size;
+  int bulk;
+  int hugepages;
+  int cold_cache;
+  int cold_cache_reads;
+  int verify;
+  char * payload;
+  char * size_dist;
+  char * access;
+  int shuffle_ranks;
+  int seed;
 };
 
 static int global_iteration = 0;
+// the threads of a process process the data sets thread_id, thread_id + o.threads, ...
+static __thread int thread_id = 0;
 
 struct benchmark_options o;
 
+// with the numeric interface of the plugin, the synchronous loops only define the names if they are needed, see main()
+static int obj_ids = 0;
+static int obj_names = 1;
+
+// the content of the objects with --payload or --verify, otherwise the buffer contains the rank
+static payload_t payload;
+static int payload_enabled = 0;
+
+// the sizes of the objects with --size-dist, otherwise all objects have the object size
+static size_dist_t size_dist;
+static int size_dist_enabled = 0;
+
+// the selection of the objects that are stated and read in the benchmark phase with --access
+typedef enum{
+  ACCESS_FIFO = 0, // the oldest object, i.e., the object that is deleted afterwards
+  ACCESS_ZIPF, // a zipfian distribution over the live objects, the newest object is the most popular
+  ACCESS_HOTSET // the newest objects are accessed with a given probability, the others uniformly
+} access_t;
+
+static access_t access_mode = ACCESS_FIFO;
+static double access_theta;
+static double access_hot_fraction;
+static double access_hot_probability;
+// the cumulative weights of the objects for ACCESS_ZIPF, the newest object first
+static double * zipf_sums = NULL;
+static __thread unsigned short access_seed[3];
+
+// with --shuffle-ranks, the ranks are permuted for each iteration before the offsets are applied
+static int * rank_perm = NULL;
+static int * rank_perm_inv = NULL;
+
 void init_options(){
   memset(& o, 0, sizeof(o));
   o.interface = "posix";
@@ -183,6 +289,14 @@ void init_options(){
   o.iterations = 3;
   o.file_size = 3901;
   o.run_info_file = "mdtest.status";
+  o.latency_format = "csv";
+  o.arrival = "fixed";
+  o.payload = "rank";
+  o.size_dist = "fixed";
+  o.access = "fifo";
+  o.queue_depth = 1;
+  o.threads = 1;
+  o.batch_size = 1;
 }
 
 static void wait(double runtime){
@@ -204,34 +318,381 @@ static void wait(double runtime){
   }
 }
 
+// the number of histograms per phase
+static int hist_count(){
+  return o.target_rate > 0 ? 2 * OP_TYPES : OP_TYPES;
+}
+
+// scheduled-start (wrk2-style) pacing with --target-rate, the operations are started according to a schedule
+// the scheduled start of the current operation in seconds since open_loop_start, negative if it is not scheduled
+static __thread double op_scheduled_start = -1;
+static __thread double open_loop_next_start;
+static __thread double open_loop_rate; // the rate of this thread
+static __thread timer open_loop_start;
+static __thread unsigned short open_loop_seed[3];
+
+// initialize the state of erand48() for the given stream of random numbers, all streams depend on --seed
+static void rand_init(unsigned short * state, uint64_t stream){
+  uint64_t x = (stream ^ (uint64_t) o.seed * 0xD1B54A32D192ED03llu) * 0x9E3779B97F4A7C15llu;
+  x ^= x >> 29;
+  state[0] = (unsigned short) x;
+  state[1] = (unsigned short) (x >> 16);
+  state[2] = (unsigned short) (x >> 32);
+}
+
+static int thread_dset_count(int tid);
+
+static void open_loop_init(){
+  start_timer(& open_loop_start);
+  open_loop_next_start = 0;
+  // the threads share the rate of the process according to the number of data sets they process
+  open_loop_rate = o.target_rate * thread_dset_count(thread_id) / o.dset_count;
+  if(! o.target_rate_per_rank){
+    open_loop_rate /= o.size;
+  }
+  rand_init(open_loop_seed, ((uint64_t) o.rank << 40) ^ ((uint64_t) thread_id << 20) ^ (uint64_t) global_iteration);
+}
+
+// wait until the scheduled start of the next operation, if we are behind schedule it starts immediately
+static void open_loop_wait(){
+  op_scheduled_start = open_loop_next_start;
+  if(o.arrival[0] == 'p'){
+    // poisson process, the inter-arrival times are exponentially distributed
+    open_loop_next_start += -log(1.0 - erand48(open_loop_seed)) / open_loop_rate;
+  }else{
+    open_loop_next_start += 1.0 / open_loop_rate;
+  }
+
+  double cur = stop_timer(open_loop_start);
+  if(op_scheduled_start - cur >= 0.01){
+    double waittime = op_scheduled_start - cur;
+    struct timespec w;
+    w.tv_sec = (time_t) (waittime);
+    w.tv_nsec = (long) ((waittime - w.tv_sec) * 1000 * 1000 * 1000);
+    nanosleep(& w, NULL);
+  }
+  while (cur < op_scheduled_start){
+    cur = stop_timer(open_loop_start);
+  }
+}
+
+// the size of an object is derived from its rank, data set and index, see object_seed()
+static uint64_t object_seed(int n, int d, int i);
+
+static size_t object_size(int n, int d, int i){
+  if(! size_dist_enabled){
+    return o.file_size;
+  }
+  return size_dist_sample(& size_dist, object_seed(n, d, i));
+}
+
+// used to compute the throughput
+static double mean_object_size(){
+  return size_dist_enabled ? size_dist.mean : o.file_size;
+}
+
+// the range of the size with sizes from 2^(bucket-1) to 2^bucket - 1, 0 for empty objects
+static int size_bucket(size_t size){
+  return size == 0 ? 0 : 64 - __builtin_clzll(size);
+}
+
+// online reporting with --report-interval, the operations completed within each interval are reduced with
+// non-blocking collectives on interval_comm, rank 0 prints an interval once the reduction completed
+typedef struct{
+  uint64_t ops[OP_TYPES];
+  histogram_t hist; // the latency of all operations
+} interval_stat_t;
+
+typedef struct{
+  MPI_Request request;
+  int index;
+  interval_stat_t * local;
+  interval_stat_t * global;
+} interval_reduction_t;
+
+static MPI_Comm interval_comm;
+static MPI_Datatype interval_type;
+static MPI_Op interval_op;
+
+static const char * interval_phase;
+static timer interval_start;
+static int interval_current; // the interval currently recorded
+static interval_stat_t * interval_local;
+// the pending reductions, they complete in order
+static interval_reduction_t * interval_pending = NULL;
+static int interval_pending_count = 0;
+static int interval_pending_size = 0;
+
+static void interval_reduce_op(void * in, void * inout, int * len, MPI_Datatype * type){
+  interval_stat_t * s_in = (interval_stat_t *) in;
+  interval_stat_t * s_inout = (interval_stat_t *) inout;
+  for(int i=0; i < *len; i++){
+    for(int op=0; op < OP_TYPES; op++){
+      s_inout[i].ops[op] += s_in[i].ops[op];
+    }
+    histogram_merge(& s_inout[i].hist, & s_in[i].hist);
+  }
+}
+
+static interval_stat_t * interval_alloc(){
+  interval_stat_t * i = (interval_stat_t *) malloc(sizeof(interval_stat_t));
+  memset(i->ops, 0, sizeof(i->ops));
+  histogram_init(& i->hist);
+  return i;
+}
+
+static void interval_print(interval_reduction_t * r){
+  interval_stat_t * g = r->global;
+  uint64_t ops = 0;
+  for(int op=0; op < OP_TYPES; op++){
+    ops += g->ops[op];
+  }
+  const double tp = (double)(g->ops[OP_CREATE] + g->ops[OP_READ]) * mean_object_size() / o.report_interval / 1024 / 1024;
+  printf("interval %s %.1fs-%.1fs rate:%.1f iops/s tp:%.1f MiB/s p50:%.4es p99:%.4es\n", interval_phase, r->index * o.report_interval, (r->index + 1) * o.report_interval, ops / o.report_interval, tp, histogram_quantile(& g->hist, 0.5), histogram_quantile(& g->hist, 0.99));
+  fflush(stdout);
+}
+
+// process the completed reductions, if wait is set wait for all of them
+static void interval_progress(int wait){
+  int done = 0;
+  for(; done < interval_pending_count; done++){
+    interval_reduction_t * r = & interval_pending[done];
+    int flag = 1;
+    if(wait){
+      MPI_Wait(& r->request, MPI_STATUS_IGNORE);
+    }else{
+      MPI_Test(& r->request, & flag, MPI_STATUS_IGNORE);
+    }
+    if(! flag){
+      break;
+    }
+    if(o.rank == 0){
+      interval_print(r);
+      free(r->global);
+    }
+    free(r->local);
+  }
+  if(done > 0){
+    interval_pending_count -= done;
+    memmove(interval_pending, interval_pending + done, sizeof(interval_reduction_t) * interval_pending_count);
+  }
+}
+
+// start the reduction of the current interval and begin the next one
+static void interval_finish(){
+  if(interval_pending_count == interval_pending_size){
+    interval_pending_size = interval_pending_size * 2 + 16;
+    interval_pending = (interval_reduction_t *) realloc(interval_pending, sizeof(interval_reduction_t) * interval_pending_size);
+  }
+  interval_reduction_t * r = & interval_pending[interval_pending_count++];
+  r->index = interval_current;
+  r->local = interval_local;
+  r->global = o.rank == 0 ? interval_alloc() : NULL;
+  int ret = MPI_Ireduce(r->local, r->global, 1, interval_type, interval_op, 0, interval_comm, & r->request);
+  CHECK_MPI_RET(ret)
+  interval_local = interval_alloc();
+  interval_current++;
+}
+
+static void interval_begin(const char * phase){
+  if(o.report_interval <= 0){
+    return;
+  }
+  interval_phase = phase;
+  interval_current = 0;
+  interval_local = interval_alloc();
+  start_timer(& interval_start);
+}
+
+static void interval_account(op_type_t op, double runtime){
+  if(o.report_interval <= 0){
+    return;
+  }
+  double now = stop_timer(interval_start);
+  while(now >= (interval_current + 1) * o.report_interval){
+    interval_finish();
+  }
+  interval_local->ops[op]++;
+  histogram_add(& interval_local->hist, runtime);
+  if(interval_pending_count > 0){
+    interval_progress(0);
+  }
+}
+
+// all processes complete the same number of intervals, the last one is partial
+static void interval_end(){
+  if(o.report_interval <= 0){
+    return;
+  }
+  int count = interval_current + 1;
+  int ret = MPI_Allreduce(MPI_IN_PLACE, & count, 1, MPI_INT, MPI_MAX, MPI_COMM_WORLD);
+  CHECK_MPI_RET(ret)
+  while(interval_current < count){
+    interval_finish();
+  }
+  interval_progress(1);
+  free(interval_local);
+  interval_local = NULL;
+}
+
 static void init_stats(phase_stat_t * p, size_t repeats){
   memset(p, 0, sizeof(phase_stat_t));
   p->repeats = repeats;
+  p->hist = (histogram_t *) malloc(sizeof(histogram_t) * hist_count());
+  for(int i=0; i < hist_count(); i++){
+    histogram_init(& p->hist[i]);
+  }
+  if(! o.latency_file_prefix || repeats == 0){
+    return;
+  }
   size_t timer_size = repeats * sizeof(time_result_t);
   p->time_create = (time_result_t *) malloc(timer_size);
   p->time_read = (time_result_t *) malloc(timer_size);
   p->time_stat = (time_result_t *) malloc(timer_size);
   p->time_delete = (time_result_t *) malloc(timer_size);
+  // not all written objects may be synced
+  p->time_sync = (time_result_t *) calloc(repeats, sizeof(time_result_t));
+}
+
+static void free_stats(phase_stat_t * p){
+  free(p->hist);
+  p->hist = NULL;
+  if(p->time_create){
+    free(p->time_create);
+    free(p->time_read);
+    free(p->time_stat);
+    free(p->time_delete);
+    free(p->time_sync);
+    p->time_create = p->time_read = p->time_stat = p->time_delete = p->time_sync = NULL;
+  }
 }
 
-static float add_timed_result(timer start, timer phase_start_timer, time_result_t * results, size_t pos, double * max_time, double * out_op_time){
-  float curtime = timer_subtract(start, phase_start_timer);
+static float add_timed_result(timer start, phase_stat_t * s, op_type_t op, time_result_t * results, size_t pos, double * out_op_time){
+  float curtime = timer_subtract(start, s->phase_start_timer);
   double op_time = stop_timer(start);
-  results[pos].runtime = (float) op_time;
-  results[pos].time_since_app_start = curtime;
-  if (op_time > *max_time){
-    *max_time = op_time;
+  double response_time = op_time;
+  if(op_scheduled_start >= 0){
+    // the response time includes the time the operation was delayed behind its schedule
+    response_time = stop_timer(open_loop_start) - op_scheduled_start;
+    histogram_add(& s->hist[OP_TYPES + op], op_time);
+    op_scheduled_start = -1;
+  }
+  histogram_add(& s->hist[op], response_time);
+  interval_account(op, response_time);
+  if(results){
+    results[pos].runtime = (float) response_time;
+    results[pos].time_since_app_start = curtime;
+  }
+  if (op_time > s->max_op_time){
+    s->max_op_time = op_time;
   }
   *out_op_time = op_time;
   return curtime;
 }
 
+// account a batch of operations, each operation is accounted with the amortized runtime of the batch
+static void add_timed_batch(timer start, phase_stat_t * s, op_type_t op, time_result_t * results, size_t * pos, int count){
+  float curtime = timer_subtract(start, s->phase_start_timer);
+  double op_time = stop_timer(start) / count;
+  for(int i=0; i < count; i++){
+    histogram_add(& s->hist[op], op_time);
+    interval_account(op, op_time);
+    if(results){
+      results[pos[i]].runtime = (float) op_time;
+      results[pos[i]].time_since_app_start = curtime;
+    }
+  }
+  if (op_time > s->max_op_time){
+    s->max_op_time = op_time;
+  }
+}
+
+// account the operation to the range of the object size with --size-dist
+static void add_size_result(phase_stat_t * s, op_type_t op, size_t size, double op_time){
+  if(! size_dist_enabled){
+    return;
+  }
+  const int b = size_bucket(size);
+  s->size_ops[op][b]++;
+  s->size_time[op][b] += op_time;
+  if (op_time > s->size_max_time[op][b]){
+    s->size_max_time[op][b] = op_time;
+  }
+}
+
+static void add_bulk_result(timer start, phase_stat_t * s){
+  double op_time = stop_timer(start);
+  s->bulk_ops++;
+  s->bulk_time += op_time;
+  if (op_time > s->bulk_max_time){
+    s->bulk_max_time = op_time;
+  }
+}
+
+// evict the object from the caches before it is read with --cold-cache-reads
+static void evict_object(phase_stat_t * s, char * dset, char * obj_name){
+  if(! o.cold_cache_reads || ! o.plugin->evict_obj){
+    return;
+  }
+  timer op_timer;
+  start_timer(& op_timer);
+  int ret = o.plugin->evict_obj(dset, obj_name);
+  if(ret == MD_NOOP){
+    return;
+  }
+  if(ret != MD_SUCCESS && o.verbosity){
+    printf("%d: Error while evicting the obj: %s\n", o.rank, obj_name);
+  }
+  s->evict_ops++;
+  s->evict_time += stop_timer(op_timer);
+}
+
+// the content of an object is derived from its rank, data set and index
+static uint64_t object_seed(int n, int d, int i){
+  return (uint64_t) n * 0x9E3779B97F4A7C15llu ^ (uint64_t) d * 0xC2B2AE3D27D4EB4Fllu ^ (uint64_t) i * 0x165667B19E3779F9llu;
+}
+
+// fill the buffer with the content of the object before it is written, with --verify this is accounted to the verification
+static void fill_object(phase_stat_t * s, char * buf, int n, int d, int i){
+  if(! payload_enabled){
+    return;
+  }
+  timer op_timer;
+  start_timer(& op_timer);
+  payload_fill(& payload, buf, object_size(n, d, i), object_seed(n, d, i));
+  if(o.verify){
+    s->verify_ops++;
+    s->verify_time += stop_timer(op_timer);
+  }
+}
+
+static void verify_check(phase_stat_t * s, char * buf, int n, int d, int i, char * obj_name){
+  if(! o.verify){
+    return;
+  }
+  timer op_timer;
+  start_timer(& op_timer);
+  int ret = payload_check(& payload, buf, object_size(n, d, i), object_seed(n, d, i));
+  s->verify_ops++;
+  s->verify_time += stop_timer(op_timer);
+  if(ret == 0){
+    s->obj_verify.suc++;
+  }else{
+    if (! obj_names){
+      o.plugin->def_obj_name(obj_name, n, d, i);
+    }
+    if (o.verbosity)
+      printf("%d: Error while verifying the obj: %s\n", o.rank, obj_name);
+    s->obj_verify.err++;
+  }
+}
+
 static void print_detailed_stat_header(){
-    printf("phase\t\td name\tcreate\tdelete\tob nam\tcreate\tread\tstat\tdelete\tt_inc_b\tt_no_bar\tthp\tmax_t\n");
+    printf("phase\t\td name\tcreate\tdelete\tob nam\tcreate\tread\tstat\tdelete\tsync\tverify\tt_inc_b\tt_no_bar\tthp\tmax_t\n");
 }
 
 static int sum_err(phase_stat_t * p){
-  return p->dset_name.err + p->dset_create.err +  p->dset_delete.err + p->obj_name.err + p->obj_create.err + p->obj_read.err + p->obj_stat.err + p->obj_delete.err;
+  return p->dset_name.err + p->dset_create.err +  p->dset_delete.err + p->obj_name.err + p->obj_create.err + p->obj_read.err + p->obj_stat.err + p->obj_delete.err + p->obj_sync.err + p->obj_verify.err;
 }
 
 static double statistics_mean(int count, double * arr){
@@ -262,8 +723,16 @@ static void statistics_minmax(int count, double * arr, double * out_min, double
   *out_max = max;
 }
 
+// with --payload, the logical and the expected physical throughput after compression and deduplication
+static int print_payload_tp(char * buff, double tp){
+  if(! payload_enabled){
+    return 0;
+  }
+  return sprintf(buff, " logical:%.1f MiB/s physical:%.1f MiB/s", tp, tp * payload_physical_fraction(& payload));
+}
+
 static void print_p_stat(char * buff, const char * name, phase_stat_t * p, double t, int print_global){
-  const double tp = (double)(p->obj_create.suc + p->obj_read.suc) * o.file_size / t / 1024 / 1024;
+  const double tp = (double)(p->obj_create.suc + p->obj_read.suc) * mean_object_size() / t / 1024 / 1024;
 
   const int errs = sum_err(p);
   double r_min = 0;
@@ -279,10 +748,10 @@ static void print_p_stat(char * buff, const char * name, phase_stat_t * p, doubl
   }
 
   if (o.print_detailed_stats){
-    sprintf(buff, "%s \t%d\t%d\t%d\t%d\t%d\t%d\t%d\t%d\t%.3fs\t%.3fs\t%.2f MiB/s %.4e", name, p->dset_name.suc, p->dset_create.suc,  p->dset_delete.suc, p->obj_name.suc, p->obj_create.suc, p->obj_read.suc,  p->obj_stat.suc, p->obj_delete.suc, p->t, t, tp, p->max_op_time);
+    sprintf(buff, "%s \t%d\t%d\t%d\t%d\t%d\t%d\t%d\t%d\t%d\t%d\t%.3fs\t%.3fs\t%.2f MiB/s %.4e", name, p->dset_name.suc, p->dset_create.suc,  p->dset_delete.suc, p->obj_name.suc, p->obj_create.suc, p->obj_read.suc,  p->obj_stat.suc, p->obj_delete.suc, p->obj_sync.suc, p->obj_verify.suc, p->t, t, tp, p->max_op_time);
 
     if (errs > 0){
-      sprintf(buff, "%s err\t%d\t%d\t%d\t%d\t%d\t%d\t%d\t%d", name, p->dset_name.err, p->dset_create.err,  p->dset_delete.err, p->obj_name.err, p->obj_create.err, p->obj_read.err, p->obj_stat.err, p->obj_delete.err);
+      sprintf(buff, "%s err\t%d\t%d\t%d\t%d\t%d\t%d\t%d\t%d\t%d\t%d", name, p->dset_name.err, p->dset_create.err,  p->dset_delete.err, p->obj_name.err, p->obj_create.err, p->obj_read.err, p->obj_stat.err, p->obj_delete.err, p->obj_sync.err, p->obj_verify.err);
     }
   }else{
     int pos = 0;
@@ -304,10 +773,15 @@ static void print_p_stat(char * buff, const char * name, phase_stat_t * p, doubl
           p->obj_read.suc / t,
           tp,
           p->max_op_time);
+        pos += print_payload_tp(buff + pos, tp);
 
         if(o.relative_waiting_factor > 1e-9){
           pos += sprintf(buff + pos, " waiting_factor:%.2f", o.relative_waiting_factor);
         }
+        if(o.target_rate > 0){
+          double rate = o.target_rate_per_rank ? o.target_rate : o.target_rate / o.size;
+          pos += sprintf(buff + pos, " target-rate:%.1f iops/s", print_global ? rate * o.size : rate);
+        }
         break;
       case('p'):
         pos += sprintf(buff + pos, "rate:%.1f iops/s dsets: %d objects:%d rate:%.3f dset/s rate:%.1f obj/s tp:%.1f MiB/s op-max:%.4es",
@@ -318,6 +792,7 @@ static void print_p_stat(char * buff, const char * name, phase_stat_t * p, doubl
           p->obj_create.suc / t,
           tp,
           p->max_op_time);
+        pos += print_payload_tp(buff + pos, tp);
         break;
       case('c'):
         pos += sprintf(buff + pos, "rate:%.1f iops/s objects:%d dsets: %d rate:%.1f obj/s rate:%.3f dset/s op-max:%.4es",
@@ -344,6 +819,21 @@ static void print_p_stat(char * buff, const char * name, phase_stat_t * p, doubl
     if(! o.quiet_output && p->stonewall_iterations){
       pos += sprintf(buff + pos, " stonewall-iter:%d", p->stonewall_iterations);
     }
+    if(! o.quiet_output && print_global){
+      pos += sprintf(buff + pos, " aggregation:%.4fs", p->t_aggregate);
+    }
+    if(p->connections >= 0){
+      pos += sprintf(buff + pos, " connections:%d", p->connections);
+    }
+    if(p->bulk_ops > 0){
+      pos += sprintf(buff + pos, " bulk(ops:%d mean:%.4es max:%.4es)", p->bulk_ops, p->bulk_time / p->bulk_ops, p->bulk_max_time);
+    }
+    if(p->evict_ops > 0){
+      pos += sprintf(buff + pos, " evict(ops:%d mean:%.4es)", p->evict_ops, p->evict_time / p->evict_ops);
+    }
+    if(p->verify_ops > 0){
+      pos += sprintf(buff + pos, " verify(ops:%d mean:%.4es verified:%d failed:%d)", p->verify_ops, p->verify_time / p->verify_ops, p->obj_verify.suc, p->obj_verify.err);
+    }
 
     if(p->stats_read.max > 1e-9){
       time_statistics_t stat = p->stats_read;
@@ -361,69 +851,321 @@ static void print_p_stat(char * buff, const char * name, phase_stat_t * p, doubl
       time_statistics_t stat = p->stats_delete;
       pos += sprintf(buff + pos, " delete(%.4es, %.4es, %.4es, %.4es, %.4es, %.4es, %.4es)", stat.min, stat.q1, stat.median, stat.q3, stat.q90, stat.q99, stat.max);
     }
+    if(p->stats_sync.max > 1e-9){
+      time_statistics_t stat = p->stats_sync;
+      pos += sprintf(buff + pos, " sync(%.4es, %.4es, %.4es, %.4es, %.4es, %.4es, %.4es)", stat.min, stat.q1, stat.median, stat.q3, stat.q90, stat.q99, stat.max);
+    }
+    if(o.target_rate > 0){
+      // the statistics above are response times, the service time excludes the delay behind the schedule
+      const char * op_names[] = {"create", "read", "stat", "delete", "sync"};
+      for(int i=0; i < OP_TYPES; i++){
+        time_statistics_t stat = p->stats_service[i];
+        if(stat.max > 1e-9){
+          pos += sprintf(buff + pos, " %s-service(%.4es, %.4es, %.4es, %.4es, %.4es, %.4es, %.4es)", op_names[i], stat.min, stat.q1, stat.median, stat.q3, stat.q90, stat.q99, stat.max);
+        }
+      }
+    }
   }
 }
 
-static int compare_floats(time_result_t * x, time_result_t * y){
-  return x->runtime < y->runtime ? -1 : (x->runtime > y->runtime ? +1 : 0);
+// print the latency of the operations per range of the object size with --size-dist, one line per range
+static void print_size_stats(const char * name, phase_stat_t * p){
+  if(! size_dist_enabled){
+    return;
+  }
+  const op_type_t ops[] = {OP_READ, OP_STAT, OP_CREATE, OP_DELETE};
+  const char * op_names[] = {"read", "stat", "create", "delete"};
+  for(int b=0; b < SIZE_BUCKETS; b++){
+    int count = 0;
+    for(int i=0; i < 4; i++){
+      count += p->size_ops[ops[i]][b];
+    }
+    if(count == 0){
+      continue;
+    }
+    printf("%s size:%llu-%llu", name, b == 0 ? 0 : 1llu << (b - 1), b == 0 ? 0 : (1llu << b) - 1);
+    for(int i=0; i < 4; i++){
+      const int op_count = p->size_ops[ops[i]][b];
+      if(op_count > 0){
+        printf(" %s(ops:%d mean:%.4es max:%.4es)", op_names[i], op_count, p->size_time[ops[i]][b] / op_count, p->size_max_time[ops[i]][b]);
+      }
+    }
+    printf("\n");
+  }
 }
 
-static double runtime_quantile(int repeats, time_result_t * times, float quantile){
-  int pos = round(quantile * repeats + 0.49);
-  return times[pos].runtime;
+// communicators for collecting the timings: the processes of a node and the first process of each node
+static MPI_Comm node_comm;
+static MPI_Comm leader_comm;
+static MPI_Datatype time_result_type;
+
+// gather the timings of all processes in comm on its rank 0, returns the number of gathered results on rank 0
+static int gather_timers(MPI_Comm comm, int repeats, time_result_t * times, time_result_t ** out_times){
+  int rank, size, ret;
+  int total = 0;
+  int * counts = NULL;
+  int * displs = NULL;
+  MPI_Comm_rank(comm, & rank);
+  MPI_Comm_size(comm, & size);
+  if(rank == 0){
+    counts = (int *) malloc(sizeof(int) * size);
+    displs = (int *) malloc(sizeof(int) * size);
+  }
+  ret = MPI_Gather(& repeats, 1, MPI_INT, counts, 1, MPI_INT, 0, comm);
+  CHECK_MPI_RET(ret)
+  if(rank == 0){
+    for(int i=0; i < size; i++){
+      displs[i] = total;
+      total += counts[i];
+    }
+    *out_times = (time_result_t *) malloc(sizeof(time_result_t) * (total > 0 ? total : 1));
+  }
+  ret = MPI_Gatherv(times, repeats, time_result_type, rank == 0 ? *out_times : NULL, counts, displs, time_result_type, 0, comm);
+  CHECK_MPI_RET(ret)
+  free(counts);
+  free(displs);
+  return total;
 }
 
-static uint64_t aggregate_timers(int repeats, int max_repeats, time_result_t * times, time_result_t * global_times){
-  uint64_t count = 0;
-  int ret;
+// collect the timings of all processes on rank 0, first per node and then across the nodes
+static uint64_t aggregate_timers(int repeats, time_result_t * times, time_result_t ** out_global_times){
   // due to stonewall, the number of repeats may be different per process
-  if(o.rank == 0){
-    MPI_Status status;
-    memcpy(global_times, times, repeats * 2 * sizeof(float));
-    count += repeats;
-    for(int i=1; i < o.size; i++){
-      int cnt;
-      ret = MPI_Recv(& global_times[count], max_repeats*2, MPI_FLOAT, i, 888, MPI_COMM_WORLD, & status);
-      CHECK_MPI_RET(ret)
-      MPI_Get_count(& status, MPI_FLOAT, & cnt);
-      count += cnt / 2;
+  time_result_t * node_times = NULL;
+  int count = gather_timers(node_comm, repeats, times, & node_times);
+  if(leader_comm == MPI_COMM_NULL){
+    return 0;
+  }
+  count = gather_timers(leader_comm, count, node_times, out_global_times);
+  free(node_times);
+  return count;
+}
+
+static void write_latency_file(const char * name, time_result_t * times, size_t repeats){
+  char file[1024];
+  sprintf(file, "%s-%.2f-%d-%s.csv", o.latency_file_prefix, o.relative_waiting_factor, global_iteration, name);
+  FILE * f = fopen(file, "w+");
+  if(f == NULL){
+    printf("%d: Error writing to latency file: %s\n", o.rank, file);
+    return;
+  }
+  fprintf(f, "time,runtime\n");
+  for(size_t i = 0; i < repeats; i++){
+    fprintf(f, "%.7f,%.4e\n", times[i].time_since_app_start, times[i].runtime);
+  }
+  fclose(f);
+}
+
+// write the individual timings of rank 0 or, with --latency-all, of all processes
+// The binary latency file contains all operations of a phase, the data is stored in native byte order
+// header, then section_count entries of latency_file_section_t, then for each section the column of the start times
+// followed by the column of the runtimes, each as count floats
+typedef struct{
+  char magic[8]; // LATENCY_FILE_MAGIC
+  uint32_t version;
+  uint32_t section_count;
+  uint32_t ranks; // the number of processes
+  uint32_t all_ranks; // 1 if the timings of all processes are included, otherwise rank 0 only
+  int32_t iteration;
+  float waiting_factor;
+  uint64_t object_size;
+  uint32_t dset_count;
+  uint32_t reserved;
+  char phase[16];
+} latency_file_header_t;
+
+typedef struct{
+  char name[16]; // the operation type
+  uint64_t count;
+  uint64_t offset; // the position of the start time column in the file
+} latency_file_section_t;
+
+#define LATENCY_FILE_MAGIC "MDWBLAT"
+#define LATENCY_FILE_VERSION 1
+
+static void write_latency_file_binary(const char * name, int count, const char ** op_names, time_result_t ** times, uint64_t * repeats){
+  char file[1024];
+  sprintf(file, "%s-%.2f-%d-%s%s.bin", o.latency_file_prefix, o.relative_waiting_factor, global_iteration, name, o.latency_keep_all ? "-all" : "");
+
+  size_t size = sizeof(latency_file_header_t) + count * sizeof(latency_file_section_t);
+  for(int i=0; i < count; i++){
+    size += repeats[i] * 2 * sizeof(float);
+  }
+  char * buff = malloc(size);
+  if(buff == NULL){
+    printf("%d: Error allocating memory for the latency file: %s\n", o.rank, file);
+    return;
+  }
+  latency_file_header_t * header = (latency_file_header_t *) buff;
+  memset(header, 0, sizeof(latency_file_header_t));
+  strcpy(header->magic, LATENCY_FILE_MAGIC);
+  header->version = LATENCY_FILE_VERSION;
+  header->section_count = count;
+  header->ranks = o.size;
+  header->all_ranks = o.latency_keep_all;
+  header->iteration = global_iteration;
+  header->waiting_factor = o.relative_waiting_factor;
+  header->object_size = o.file_size;
+  header->dset_count = o.dset_count;
+  snprintf(header->phase, sizeof(header->phase), "%s", name);
+
+  latency_file_section_t * sections = (latency_file_section_t *) (buff + sizeof(latency_file_header_t));
+  uint64_t offset = sizeof(latency_file_header_t) + count * sizeof(latency_file_section_t);
+  for(int i=0; i < count; i++){
+    memset(& sections[i], 0, sizeof(latency_file_section_t));
+    snprintf(sections[i].name, sizeof(sections[i].name), "%s", op_names[i]);
+    sections[i].count = repeats[i];
+    sections[i].offset = offset;
+    float * time_col = (float *) (buff + offset);
+    float * runtime_col = time_col + repeats[i];
+    for(uint64_t r = 0; r < repeats[i]; r++){
+      time_col[r] = times[i][r].time_since_app_start;
+      runtime_col[r] = times[i][r].runtime;
     }
-  }else{
-    ret = MPI_Send(times, repeats * 2, MPI_FLOAT, 0, 888, MPI_COMM_WORLD);
-    CHECK_MPI_RET(ret)
+    offset += repeats[i] * 2 * sizeof(float);
   }
 
-  return count;
+  FILE * f = fopen(file, "w+");
+  if(f == NULL){
+    printf("%d: Error writing to latency file: %s\n", o.rank, file);
+    free(buff);
+    return;
+  }
+  if(fwrite(buff, size, 1, f) != 1){
+    printf("%d: Error writing to latency file: %s\n", o.rank, file);
+  }
+  fclose(f);
+  free(buff);
 }
 
-static void compute_histogram(const char * name, time_result_t * times, time_statistics_t * stats, size_t repeats, int writeLatencyFile){
-  if(writeLatencyFile && o.latency_file_prefix ){
-    char file[1024];
-    sprintf(file, "%s-%.2f-%d-%s.csv", o.latency_file_prefix, o.relative_waiting_factor, global_iteration, name);
-    FILE * f = fopen(file, "w+");
-    if(f == NULL){
+// The shared latency file contains the timings of all processes for one operation type, it is written collectively
+// header, then for each process a latency_shared_index_t, then the time_result_t records of all processes
+typedef struct{
+  char magic[8]; // LATENCY_SHARED_FILE_MAGIC
+  uint32_t version;
+  uint32_t ranks;
+  int32_t iteration;
+  float waiting_factor;
+  uint64_t object_size;
+  uint32_t dset_count;
+  uint32_t reserved;
+  char name[16]; // the operation type
+} latency_shared_header_t;
+
+typedef struct{
+  uint64_t count;
+  uint64_t offset; // the position of the first record of the process in the file
+} latency_shared_index_t;
+
+#define LATENCY_SHARED_FILE_MAGIC "MDWBSHR"
+
+static void write_latency_file_shared(const char * name, const char * op_name, time_result_t * times, uint64_t repeats){
+  char file[1024];
+  int ret;
+  sprintf(file, "%s-%.2f-%d-%s-all.lat", o.latency_file_prefix, o.relative_waiting_factor, global_iteration, name);
+
+  const uint64_t data_start = sizeof(latency_shared_header_t) + o.size * sizeof(latency_shared_index_t);
+  uint64_t size = repeats * sizeof(time_result_t);
+  uint64_t offset = 0;
+  ret = MPI_Exscan(& size, & offset, 1, MPI_UINT64_T, MPI_SUM, MPI_COMM_WORLD);
+  CHECK_MPI_RET(ret)
+  if(o.rank == 0){
+    offset = 0; // undefined for rank 0
+  }
+  latency_shared_index_t index = {repeats, data_start + offset};
+
+  MPI_File fh;
+  ret = MPI_File_open(MPI_COMM_WORLD, file, MPI_MODE_CREATE | MPI_MODE_WRONLY, MPI_INFO_NULL, & fh);
+  if(ret != MPI_SUCCESS){
+    if(o.rank == 0){
       printf("%d: Error writing to latency file: %s\n", o.rank, file);
-      return;
     }
-    fprintf(f, "time,runtime\n");
-    for(size_t i = 0; i < repeats; i++){
-      fprintf(f, "%.7f,%.4e\n", times[i].time_since_app_start, times[i].runtime);
+    return;
+  }
+  ret = MPI_File_set_size(fh, 0);
+  CHECK_MPI_RET(ret)
+
+  latency_shared_header_t header;
+  memset(& header, 0, sizeof(header));
+  strcpy(header.magic, LATENCY_SHARED_FILE_MAGIC);
+  header.version = LATENCY_FILE_VERSION;
+  header.ranks = o.size;
+  header.iteration = global_iteration;
+  header.waiting_factor = o.relative_waiting_factor;
+  header.object_size = o.file_size;
+  header.dset_count = o.dset_count;
+  snprintf(header.name, sizeof(header.name), "%s", op_name);
+  ret = MPI_File_write_at_all(fh, 0, & header, o.rank == 0 ? sizeof(header) : 0, MPI_BYTE, MPI_STATUS_IGNORE);
+  CHECK_MPI_RET(ret)
+  ret = MPI_File_write_at_all(fh, sizeof(header) + o.rank * sizeof(latency_shared_index_t), & index, sizeof(index), MPI_BYTE, MPI_STATUS_IGNORE);
+  CHECK_MPI_RET(ret)
+  ret = MPI_File_write_at_all(fh, index.offset, times, (int) repeats, time_result_type, MPI_STATUS_IGNORE);
+  CHECK_MPI_RET(ret)
+  MPI_File_close(& fh);
+}
+
+// write the individual timings of the operations of a phase for rank 0 or, with --latency-all, for all processes
+static void store_latencies(const char * name, phase_stat_t * p, int count, const char ** op_names, time_result_t ** times){
+  if(! o.latency_file_prefix){
+    return;
+  }
+  if(strcmp(o.latency_format, "mpiio") == 0){
+    for(int i=0; i < count; i++){
+      write_latency_file_shared(count == 1 ? name : op_names[i], op_names[i], times[i], p->repeats);
     }
-    fclose(f);
+    return;
   }
-  // now sort the times and pick the quantiles
-  qsort(times, repeats, sizeof(time_result_t), (int (*)(const void *, const void *)) compare_floats);
-  stats->min = times[0].runtime;
-  stats->q1 = runtime_quantile(repeats, times, 0.25);
-  if(repeats % 2 == 0){
-    stats->median = (times[repeats/2].runtime + times[repeats/2 - 1].runtime)/2.0;
-  }else{
-    stats->median = times[repeats/2].runtime;
+
+  time_result_t * out_times[OP_TYPES];
+  uint64_t repeats[OP_TYPES];
+  for(int i=0; i < count; i++){
+    if(o.latency_keep_all){
+      out_times[i] = NULL;
+      repeats[i] = aggregate_timers(p->repeats, times[i], & out_times[i]);
+    }else{
+      out_times[i] = times[i];
+      repeats[i] = p->repeats;
+    }
+  }
+
+  if(o.rank == 0){
+    if(strcmp(o.latency_format, "binary") == 0){
+      write_latency_file_binary(name, count, op_names, out_times, repeats);
+    }else{
+      char file_name[1024];
+      for(int i=0; i < count; i++){
+        // the CSV files of a phase with a single operation type are named after the phase
+        sprintf(file_name, "%s%s", count == 1 ? name : op_names[i], o.latency_keep_all ? "-all" : "");
+        write_latency_file(file_name, out_times[i], repeats[i]);
+      }
+    }
+  }
+
+  if(o.latency_keep_all){
+    for(int i=0; i < count; i++){
+      free(out_times[i]);
+    }
+  }
+}
+
+static void compute_statistics(histogram_t * h, time_statistics_t * stats){
+  stats->min = h->min;
+  stats->q1 = histogram_quantile(h, 0.25);
+  stats->median = histogram_quantile(h, 0.5);
+  stats->q3 = histogram_quantile(h, 0.75);
+  stats->q90 = histogram_quantile(h, 0.90);
+  stats->q99 = histogram_quantile(h, 0.99);
+  stats->max = h->max;
+}
+
+static MPI_Datatype histogram_type;
+static MPI_Op histogram_op;
+
+static void histogram_reduce_op(void * in, void * inout, int * len, MPI_Datatype * type){
+  histogram_t * h_in = (histogram_t *) in;
+  histogram_t * h_inout = (histogram_t *) inout;
+  for(int i=0; i < *len; i++){
+    histogram_merge(& h_inout[i], & h_in[i]);
   }
-  stats->q3 = runtime_quantile(repeats, times, 0.75);
-  stats->q90 = runtime_quantile(repeats, times, 0.90);
-  stats->q99 = runtime_quantile(repeats, times, 0.99);
-  stats->max = times[repeats - 1].runtime;
 }
 
 static void end_phase(const char * name, phase_stat_t * p){
@@ -433,14 +1175,12 @@ static void end_phase(const char * name, phase_stat_t * p){
   char * limit_memory_P = NULL;
   MPI_Barrier(MPI_COMM_WORLD);
 
-  int max_repeats = o.precreate * o.dset_count;
-  if(strcmp(name,"benchmark") == 0){
-    max_repeats = o.num * o.dset_count;
-  }
+  timer aggregate_timer;
+  start_timer(& aggregate_timer);
 
   // prepare the summarized report
   phase_stat_t g_stat;
-  init_stats(& g_stat, (o.rank == 0 ? 1 : 0) * ((size_t) max_repeats) * o.size);
+  init_stats(& g_stat, 0);
   // reduce timers
   ret = MPI_Reduce(& p->t, & g_stat.t, 2, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD);
   CHECK_MPI_RET(ret)
@@ -449,54 +1189,90 @@ static void end_phase(const char * name, phase_stat_t * p){
   }
   ret = MPI_Gather(& p->t, 1, MPI_DOUBLE, g_stat.t_all, 1, MPI_DOUBLE, 0, MPI_COMM_WORLD);
   CHECK_MPI_RET(ret)
-  ret = MPI_Reduce(& p->dset_name, & g_stat.dset_name, 2*(3+5), MPI_INT, MPI_SUM, 0, MPI_COMM_WORLD);
+  ret = MPI_Reduce(& p->dset_name, & g_stat.dset_name, 2*(3+7), MPI_INT, MPI_SUM, 0, MPI_COMM_WORLD);
   CHECK_MPI_RET(ret)
   ret = MPI_Reduce(& p->max_op_time, & g_stat.max_op_time, 1, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD);
   CHECK_MPI_RET(ret)
+  ret = MPI_Reduce(& p->connections, & g_stat.connections, 1, MPI_INT, MPI_SUM, 0, MPI_COMM_WORLD);
+  CHECK_MPI_RET(ret)
+  ret = MPI_Reduce(& p->bulk_ops, & g_stat.bulk_ops, 1, MPI_INT, MPI_SUM, 0, MPI_COMM_WORLD);
+  CHECK_MPI_RET(ret)
+  ret = MPI_Reduce(& p->bulk_time, & g_stat.bulk_time, 1, MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD);
+  CHECK_MPI_RET(ret)
+  ret = MPI_Reduce(& p->bulk_max_time, & g_stat.bulk_max_time, 1, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD);
+  CHECK_MPI_RET(ret)
+  ret = MPI_Reduce(& p->evict_ops, & g_stat.evict_ops, 1, MPI_INT, MPI_SUM, 0, MPI_COMM_WORLD);
+  CHECK_MPI_RET(ret)
+  ret = MPI_Reduce(& p->evict_time, & g_stat.evict_time, 1, MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD);
+  CHECK_MPI_RET(ret)
+  ret = MPI_Reduce(& p->verify_ops, & g_stat.verify_ops, 1, MPI_INT, MPI_SUM, 0, MPI_COMM_WORLD);
+  CHECK_MPI_RET(ret)
+  ret = MPI_Reduce(& p->verify_time, & g_stat.verify_time, 1, MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD);
+  CHECK_MPI_RET(ret)
+  if(size_dist_enabled){
+    ret = MPI_Reduce(p->size_ops, g_stat.size_ops, OP_TYPES * SIZE_BUCKETS, MPI_INT, MPI_SUM, 0, MPI_COMM_WORLD);
+    CHECK_MPI_RET(ret)
+    ret = MPI_Reduce(p->size_time, g_stat.size_time, OP_TYPES * SIZE_BUCKETS, MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD);
+    CHECK_MPI_RET(ret)
+    ret = MPI_Reduce(p->size_max_time, g_stat.size_max_time, OP_TYPES * SIZE_BUCKETS, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD);
+    CHECK_MPI_RET(ret)
+  }
   if( p->stonewall_iterations ){
     ret = MPI_Reduce(& p->repeats, & g_stat.repeats, 1, MPI_UINT64_T, MPI_MIN, 0, MPI_COMM_WORLD);
     CHECK_MPI_RET(ret)
     g_stat.stonewall_iterations = p->stonewall_iterations;
   }
-  int write_rank0_latency_file = (o.rank == 0) && ! o.latency_keep_all;
+  // merge the histograms of all operation types
+  ret = MPI_Reduce(p->hist, g_stat.hist, hist_count(), histogram_type, histogram_op, 0, MPI_COMM_WORLD);
+  CHECK_MPI_RET(ret)
+
+  // the sync latencies are stored if any process synced the objects it wrote
+  int synced = 0;
+  if(o.latency_file_prefix){
+    synced = p->obj_sync.suc + p->obj_sync.err > 0;
+    ret = MPI_Allreduce(MPI_IN_PLACE, & synced, 1, MPI_INT, MPI_MAX, MPI_COMM_WORLD);
+    CHECK_MPI_RET(ret)
+  }
 
   if(strcmp(name,"precreate") == 0){
-    uint64_t repeats = aggregate_timers(p->repeats, max_repeats, p->time_create, g_stat.time_create);
-    if(o.rank == 0){
-      compute_histogram("precreate-all", g_stat.time_create, & g_stat.stats_create, repeats, o.latency_keep_all);
+    const char * op_names[] = {"create"};
+    time_result_t * times[] = {p->time_create};
+    store_latencies(name, p, 1, op_names, times);
+    if(synced){
+      const char * sync_names[] = {"sync"};
+      time_result_t * sync_times[] = {p->time_sync};
+      store_latencies("precreate-sync", p, 1, sync_names, sync_times);
     }
-    compute_histogram("precreate", p->time_create, & p->stats_create, p->repeats, write_rank0_latency_file);
   }else if(strcmp(name,"cleanup") == 0){
-    uint64_t repeats = aggregate_timers(p->repeats, max_repeats, p->time_delete, g_stat.time_delete);
-    if(o.rank == 0) {
-      compute_histogram("cleanup-all", g_stat.time_delete, & g_stat.stats_delete, repeats, o.latency_keep_all);
-    }
-    compute_histogram("cleanup", p->time_delete, & p->stats_delete, p->repeats, write_rank0_latency_file);
+    const char * op_names[] = {"delete"};
+    time_result_t * times[] = {p->time_delete};
+    store_latencies(name, p, 1, op_names, times);
   }else if(strcmp(name,"benchmark") == 0){
-    uint64_t repeats = aggregate_timers(p->repeats, max_repeats, p->time_read, g_stat.time_read);
-    if(o.rank == 0) {
-      compute_histogram("read-all", g_stat.time_read, & g_stat.stats_read, repeats, o.latency_keep_all);
-    }
-    compute_histogram("read", p->time_read, & p->stats_read, p->repeats, write_rank0_latency_file);
-
-    repeats = aggregate_timers(p->repeats, max_repeats, p->time_stat, g_stat.time_stat);
-    if(o.rank == 0) {
-      compute_histogram("stat-all", g_stat.time_stat, & g_stat.stats_stat, repeats, o.latency_keep_all);
-    }
-    compute_histogram("stat", p->time_stat, & p->stats_stat, p->repeats, write_rank0_latency_file);
+    const char * op_names[] = {"read", "stat", "create", "delete", "sync"};
+    time_result_t * times[] = {p->time_read, p->time_stat, p->time_create, p->time_delete, p->time_sync};
+    store_latencies(name, p, o.read_only ? 2 : (synced ? 5 : 4), op_names, times);
+  }
 
-    if(! o.read_only){
-      repeats = aggregate_timers(p->repeats, max_repeats, p->time_create, g_stat.time_create);
-      if(o.rank == 0) {
-        compute_histogram("create-all", g_stat.time_create, & g_stat.stats_create, repeats, o.latency_keep_all);
-      }
-      compute_histogram("create", p->time_create, & p->stats_create, p->repeats, write_rank0_latency_file);
+  g_stat.t_aggregate = stop_timer(aggregate_timer);
 
-      repeats = aggregate_timers(p->repeats, max_repeats, p->time_delete, g_stat.time_delete);
-      if(o.rank == 0) {
-        compute_histogram("delete-all", g_stat.time_delete, & g_stat.stats_delete, repeats, o.latency_keep_all);
+  compute_statistics(& p->hist[OP_CREATE], & p->stats_create);
+  compute_statistics(& p->hist[OP_READ], & p->stats_read);
+  compute_statistics(& p->hist[OP_STAT], & p->stats_stat);
+  compute_statistics(& p->hist[OP_DELETE], & p->stats_delete);
+  compute_statistics(& p->hist[OP_SYNC], & p->stats_sync);
+  if(o.rank == 0){
+    compute_statistics(& g_stat.hist[OP_CREATE], & g_stat.stats_create);
+    compute_statistics(& g_stat.hist[OP_READ], & g_stat.stats_read);
+    compute_statistics(& g_stat.hist[OP_STAT], & g_stat.stats_stat);
+    compute_statistics(& g_stat.hist[OP_DELETE], & g_stat.stats_delete);
+    compute_statistics(& g_stat.hist[OP_SYNC], & g_stat.stats_sync);
+  }
+  if(o.target_rate > 0){
+    for(int i=0; i < OP_TYPES; i++){
+      compute_statistics(& p->hist[OP_TYPES + i], & p->stats_service[i]);
+      if(o.rank == 0){
+        compute_statistics(& g_stat.hist[OP_TYPES + i], & g_stat.stats_service[i]);
       }
-      compute_histogram("delete", p->time_delete, & p->stats_delete, p->repeats, write_rank0_latency_file);
     }
   }
 
@@ -504,6 +1280,7 @@ static void end_phase(const char * name, phase_stat_t * p){
     //print the stats:
     print_p_stat(buff, name, & g_stat, g_stat.t, 1);
     printf("%s\n", buff);
+    print_size_stats(name, & g_stat);
   }
 
   if(o.process_report){
@@ -523,18 +1300,8 @@ static void end_phase(const char * name, phase_stat_t * p){
   if(g_stat.t_all){
     free(g_stat.t_all);
   }
-  if(p->time_create){
-    free(p->time_create);
-    free(p->time_read);
-    free(p->time_stat);
-    free(p->time_delete);
-  }
-  if(g_stat.time_create){
-    free(g_stat.time_create);
-    free(g_stat.time_read);
-    free(g_stat.time_stat);
-    free(g_stat.time_delete);
-  }
+  free_stats(p);
+  free_stats(& g_stat);
 
   // allocate if necessary
   ret = mem_preallocate(& limit_memory_P, o.limit_memory_between_phases, o.verbosity >= 3);
@@ -544,12 +1311,271 @@ static void end_phase(const char * name, phase_stat_t * p){
   mem_free_preallocated(& limit_memory_P);
 }
 
+// the I/O buffers passed to the plugins are aligned and padded, see mem_alloc_aligned()
+static char * alloc_buffer(){
+  char * buf = mem_alloc_aligned(o.file_size, o.hugepages);
+  if(buf == NULL){
+    printf("%d: Error allocating the I/O buffer\n", o.rank);
+    MPI_Abort(MPI_COMM_WORLD, 1);
+  }
+  if(payload_enabled){
+    // the buffer of the batched and asynchronous operations is shared by the objects
+    payload_fill(& payload, buf, MEM_PADDED_SIZE(o.file_size), object_seed(o.rank, 0, thread_id));
+  }else{
+    memset(buf, o.rank % 256, MEM_PADDED_SIZE(o.file_size));
+  }
+  return buf;
+}
+
+static void free_buffer(char * buf){
+  mem_free_aligned(buf, o.file_size, o.hugepages);
+}
+
+// a batch of objects for the batched plugin interface, used with --batch-size
+typedef struct{
+  int count;
+  char * slots; // the name buffers of all slots, allocated once
+  char ** dsets;
+  char ** names;
+  char ** bufs;
+  int * ret;
+  size_t * pos; // position inside the individual measurement array
+  int * d;
+  int * file;
+} obj_batch_t;
+
+#define BATCH_NAME_LEN 4096
+
+static obj_batch_t * batch_alloc(){
+  obj_batch_t * b = (obj_batch_t *) malloc(sizeof(obj_batch_t));
+  b->count = 0;
+  b->slots = (char *) malloc(2 * BATCH_NAME_LEN * (size_t) o.batch_size);
+  b->dsets = (char **) malloc(sizeof(char *) * o.batch_size);
+  b->names = (char **) malloc(sizeof(char *) * o.batch_size);
+  b->bufs = (char **) malloc(sizeof(char *) * o.batch_size);
+  b->ret = (int *) malloc(sizeof(int) * o.batch_size);
+  b->pos = (size_t *) malloc(sizeof(size_t) * o.batch_size);
+  b->d = (int *) malloc(sizeof(int) * o.batch_size);
+  b->file = (int *) malloc(sizeof(int) * o.batch_size);
+  for(int i=0; i < o.batch_size; i++){
+    b->dsets[i] = b->slots + 2 * i * (size_t) BATCH_NAME_LEN;
+    b->names[i] = b->dsets[i] + BATCH_NAME_LEN;
+  }
+  return b;
+}
+
+static void batch_add(obj_batch_t * b, char * dset, char * obj_name, size_t pos, int d, int file){
+  int i = b->count++;
+  strcpy(b->dsets[i], dset);
+  strcpy(b->names[i], obj_name);
+  b->pos[i] = pos;
+  b->d[i] = d;
+  b->file[i] = file;
+}
+
+// keep the objects for which ret is set, remove the others; the slots are swapped so that all buffers remain owned by the batch
+static void batch_compact(obj_batch_t * b){
+  int k = 0;
+  for(int i=0; i < b->count; i++){
+    if(! b->ret[i]){
+      continue;
+    }
+    char * dset = b->dsets[k];
+    char * name = b->names[k];
+    b->dsets[k] = b->dsets[i];
+    b->names[k] = b->names[i];
+    b->dsets[i] = dset;
+    b->names[i] = name;
+    b->pos[k] = b->pos[i];
+    b->d[k] = b->d[i];
+    b->file[k] = b->file[i];
+    k++;
+  }
+  b->count = k;
+}
+
+static void batch_clear(obj_batch_t * b){
+  b->count = 0;
+}
+
+static void batch_free(obj_batch_t * b){
+  free(b->slots);
+  free(b->dsets);
+  free(b->names);
+  free(b->bufs);
+  free(b->ret);
+  free(b->pos);
+  free(b->d);
+  free(b->file);
+  free(b);
+}
+
+// run the operation on all objects of the batch, the return codes are stored in b->ret
+static void batch_run(phase_stat_t * s, obj_batch_t * b, op_type_t op, time_result_t * results, char * buf){
+  timer op_timer;
+  int ret;
+  for(int i=0; i < b->count; i++){
+    b->bufs[i] = buf;
+  }
+  start_timer(& op_timer);
+  switch(op){
+    case(OP_CREATE):
+      ret = o.plugin->write_objs(b->count, b->dsets, b->names, b->bufs, o.file_size, b->ret);
+      break;
+    case(OP_READ):
+      ret = o.plugin->read_objs(b->count, b->dsets, b->names, b->bufs, o.file_size, b->ret);
+      break;
+    case(OP_STAT):
+      ret = o.plugin->stat_objs(b->count, b->dsets, b->names, o.file_size, b->ret);
+      break;
+    default:
+      ret = o.plugin->delete_objs(b->count, b->dsets, b->names, b->ret);
+      break;
+  }
+  add_timed_batch(op_timer, s, op, results, b->pos, b->count);
+  if(ret != MD_SUCCESS){
+    for(int i=0; i < b->count; i++){
+      b->ret[i] = ret;
+    }
+  }
+}
+
+static void check_precreate_result(phase_stat_t * s, int ret, char * dset, char * obj_name){
+  if (o.verbosity >= 2){
+    printf("%d: write %s:%s (%d)\n", o.rank, dset, obj_name, ret);
+  }
+
+  if (ret == MD_NOOP){
+    // do not increment any counter
+  }else if (ret == MD_SUCCESS){
+    s->obj_create.suc++;
+  }else{
+    s->obj_create.err++;
+    if (! o.ignore_precreate_errors){
+      printf("%d: Error while creating the obj: %s\n", o.rank, obj_name);
+      fflush(stdout);
+      MPI_Abort(MPI_COMM_WORLD, 1);
+    }
+  }
+}
+
+static void precreate_batch(phase_stat_t * s, obj_batch_t * b, char * buf){
+  if(b->count == 0){
+    return;
+  }
+  batch_run(s, b, OP_CREATE, s->time_create, buf);
+  for(int i=0; i < b->count; i++){
+    check_precreate_result(s, b->ret[i], b->dsets[i], b->names[i]);
+  }
+  batch_clear(b);
+}
+
+static int define_names(char * dset, char * obj_name, int n, int d, int i){
+  if(! obj_names){
+    return MD_SUCCESS;
+  }
+  int ret = o.plugin->def_obj_name(obj_name, n, d, i);
+  if(ret != MD_SUCCESS){
+    return ret;
+  }
+  o.plugin->def_dset_name(dset, n, d);
+  return MD_SUCCESS;
+}
+
+// with the numeric interface, the names are defined if the operation failed to report the object in the error messages
+static int id_result(char * dset, char * obj_name, int n, int d, int i, int ret){
+  if(! obj_names && ret != MD_SUCCESS && ret != MD_NOOP){
+    o.plugin->def_obj_name(obj_name, n, d, i);
+    o.plugin->def_dset_name(dset, n, d);
+  }
+  return ret;
+}
+
+static int write_object(char * dset, char * obj_name, int n, int d, int i, char * buf, size_t size){
+  if(obj_ids){
+    return id_result(dset, obj_name, n, d, i, o.plugin->write_obj_id(n, d, i, buf, size));
+  }
+  return o.plugin->write_obj(dset, obj_name, buf, size);
+}
+
+static int read_object(char * dset, char * obj_name, int n, int d, int i, char * buf, size_t size){
+  if(obj_ids){
+    return id_result(dset, obj_name, n, d, i, o.plugin->read_obj_id(n, d, i, buf, size));
+  }
+  return o.plugin->read_obj(dset, obj_name, buf, size);
+}
+
+static int stat_object(char * dset, char * obj_name, int n, int d, int i, size_t size){
+  if(obj_ids){
+    return id_result(dset, obj_name, n, d, i, o.plugin->stat_obj_id(n, d, i, size));
+  }
+  return o.plugin->stat_obj(dset, obj_name, size);
+}
+
+static int delete_object(char * dset, char * obj_name, int n, int d, int i){
+  if(obj_ids){
+    return id_result(dset, obj_name, n, d, i, o.plugin->delete_obj_id(n, d, i));
+  }
+  return o.plugin->delete_obj(dset, obj_name);
+}
+
+static void check_sync_result(phase_stat_t * s, int ret, int count, char * name){
+  if (o.verbosity >= 2){
+    printf("%d: sync %s (%d)\n", o.rank, name, ret);
+  }
+
+  if (ret == MD_SUCCESS){
+    s->obj_sync.suc += count;
+  }else{
+    if (o.verbosity)
+      printf("%d: Error while syncing: %s\n", o.rank, name);
+    s->obj_sync.err += count;
+  }
+}
+
+// make an object durable after it was written or, then results is NULL, deleted
+static void sync_object(phase_stat_t * s, char * dset, char * obj_name, time_result_t * results, size_t pos){
+  if(! o.plugin->sync_obj){
+    return;
+  }
+  timer op_timer;
+  double op_time;
+  start_timer(& op_timer);
+  int ret = o.plugin->sync_obj(dset, obj_name);
+  if(ret == MD_NOOP){
+    return;
+  }
+  add_timed_result(op_timer, s, OP_SYNC, results, pos, & op_time);
+  check_sync_result(s, ret, 1, obj_name);
+}
+
+// make count objects durable at once that were written at the positions pos or, then pos is NULL, deleted
+// each object is accounted with the amortized time of the sync
+static void sync_dsets(phase_stat_t * s, size_t * pos, int count){
+  if(! o.plugin->sync_dsets || count == 0){
+    return;
+  }
+  timer op_timer;
+  start_timer(& op_timer);
+  int ret = o.plugin->sync_dsets();
+  if(ret == MD_NOOP){
+    return;
+  }
+  add_timed_batch(op_timer, s, OP_SYNC, pos ? s->time_sync : NULL, pos, count);
+  check_sync_result(s, ret, count, "dsets");
+}
+
+// the number of data sets processed by the given thread
+static int thread_dset_count(int tid){
+  return (o.dset_count - tid + o.threads - 1) / o.threads;
+}
+
 void run_precreate(phase_stat_t * s, int current_index){
-  char dset[4096];
-  char obj_name[4096];
+  char dset[4096] = "";
+  char obj_name[4096] = "";
   int ret;
 
-  for(int i=0; i < o.dset_count; i++){
+  for(int i=thread_id; i < o.dset_count; i += o.threads){
     ret = o.plugin->def_dset_name(dset, o.rank, i);
     if (ret != MD_SUCCESS){
       if (! o.ignore_precreate_errors){
@@ -574,18 +1600,77 @@ void run_precreate(phase_stat_t * s, int current_index){
     }
   }
 
-  char * buf = malloc(o.file_size);
-  memset(buf, o.rank % 256, o.file_size);
+  char * buf = alloc_buffer();
   timer op_timer; // timer for individual operations
   size_t pos = -1; // position inside the individual measurement array
   double op_time;
+  obj_batch_t * batch = o.batch_size > 1 && o.plugin->write_objs ? batch_alloc() : NULL;
+  // the objects written in the current iteration over the data sets
+  size_t * written = (size_t *) malloc(sizeof(size_t) * o.dset_count);
+  int written_count = 0;
+
+  if (o.bulk && o.plugin->bulk_create_objs){
+    for(int d=thread_id; d < o.dset_count; d += o.threads){
+      int count;
+      ret = o.plugin->def_dset_name(dset, o.rank, d);
+      start_timer(& op_timer);
+      ret = o.plugin->bulk_create_objs(dset, o.rank, d, current_index, o.precreate, buf, o.file_size, & count);
+      add_bulk_result(op_timer, s);
+      if (o.verbosity >= 2){
+        printf("%d: bulk write %s (%d objs, %d)\n", o.rank, dset, count, ret);
+      }
+      s->obj_create.suc += count;
+      if (ret != MD_SUCCESS){
+        s->obj_create.err += o.precreate - current_index - count;
+        if (! o.ignore_precreate_errors){
+          printf("%d: Error while creating the objs in the dset: %s\n", o.rank, dset);
+          fflush(stdout);
+          MPI_Abort(MPI_COMM_WORLD, 1);
+        }
+      }
+    }
+    // no individual measurements
+    s->repeats = 0;
+    free(written);
+    free_buffer(buf);
+    return;
+  }
+
+  if (batch){
+    // fill each batch from one data set, so plugins can submit it as one request per data set
+    const int dset_count = thread_dset_count(thread_id);
+    for(int d=thread_id; d < o.dset_count; d += o.threads){
+      for(int f=current_index; f < o.precreate; f++){
+        pos = (size_t) (f - current_index) * dset_count + (d - thread_id) / o.threads;
+        ret = define_names(dset, obj_name, o.rank, d, f);
+        if (ret != MD_SUCCESS){
+          s->dset_name.err++;
+          if (! o.ignore_precreate_errors){
+            printf("%d: Error while creating the obj name\n", o.rank);
+            fflush(stdout);
+            MPI_Abort(MPI_COMM_WORLD, 1);
+          }
+          s->obj_name.err++;
+          continue;
+        }
+        batch_add(batch, dset, obj_name, pos, d, f);
+        if (batch->count == o.batch_size){
+          precreate_batch(s, batch, buf);
+        }
+      }
+      precreate_batch(s, batch, buf);
+    }
+    batch_free(batch);
+    free(written);
+    free_buffer(buf);
+    return;
+  }
 
   // create the obj
   for(int f=current_index; f < o.precreate; f++){
-    for(int d=0; d < o.dset_count; d++){
-      ret = o.plugin->def_dset_name(dset, o.rank, d);
+    for(int d=thread_id; d < o.dset_count; d += o.threads){
       pos++;
-      ret = o.plugin->def_obj_name(obj_name, o.rank, d, f);
+      ret = define_names(dset, obj_name, o.rank, d, f);
       if (ret != MD_SUCCESS){
         s->dset_name.err++;
         if (! o.ignore_precreate_errors){
@@ -597,38 +1682,172 @@ void run_precreate(phase_stat_t * s, int current_index){
         continue;
       }
 
+      const size_t size = object_size(o.rank, d, f);
+      fill_object(s, buf, o.rank, d, f);
       start_timer(& op_timer);
-      ret = o.plugin->write_obj(dset, obj_name, buf, o.file_size);
-      add_timed_result(op_timer, s->phase_start_timer, s->time_create, pos, & s->max_op_time, & op_time);
-
-      if (o.verbosity >= 2){
-        printf("%d: write %s:%s (%d)\n", o.rank, dset, obj_name, ret);
+      ret = write_object(dset, obj_name, o.rank, d, f, buf, size);
+      add_timed_result(op_timer, s, OP_CREATE, s->time_create, pos, & op_time);
+      add_size_result(s, OP_CREATE, size, op_time);
+      check_precreate_result(s, ret, dset, obj_name);
+      if (ret == MD_SUCCESS){
+        sync_object(s, dset, obj_name, s->time_sync, pos);
+        written[written_count++] = pos;
       }
+    }
+    sync_dsets(s, written, written_count);
+    written_count = 0;
+  }
+  free(written);
+  free_buffer(buf);
+}
+
+static int bench_read_rank(int d){
+  if(rank_perm){
+    int pos = (rank_perm_inv[o.rank] - o.offset * (d+1)) % o.size;
+    return rank_perm[pos < 0 ? pos + o.size : pos];
+  }
+  int readRank = (o.rank - o.offset * (d+1)) % o.size;
+  return readRank < 0 ? readRank + o.size : readRank;
+}
+
+static int bench_write_rank(int d){
+  if(rank_perm){
+    return rank_perm[(rank_perm_inv[o.rank] + o.offset * (d+1)) % o.size];
+  }
+  return (o.rank + o.offset * (d+1)) % o.size;
+}
+
+// draw the permutation of the ranks for the current iteration, all processes use the same permutation
+static void shuffle_ranks(){
+  unsigned short seed[3];
+  rand_init(seed, global_iteration);
+  if(! rank_perm){
+    rank_perm = (int *) malloc(sizeof(int) * o.size);
+    rank_perm_inv = (int *) malloc(sizeof(int) * o.size);
+  }
+  for(int i=0; i < o.size; i++){
+    rank_perm[i] = i;
+  }
+  for(int i=o.size - 1; i > 0; i--){
+    int j = (int) (erand48(seed) * (i + 1));
+    int tmp = rank_perm[i];
+    rank_perm[i] = rank_perm[j];
+    rank_perm[j] = tmp;
+  }
+  for(int i=0; i < o.size; i++){
+    rank_perm_inv[rank_perm[i]] = i;
+  }
+}
 
-      if (ret == MD_NOOP){
-        // do not increment any counter
-      }else if (ret == MD_SUCCESS){
-        s->obj_create.suc++;
+// the index of the object that is stated and read instead of the oldest object fifo_index
+// the objects from fifo_index to window_end - 1 existed at the start of the phase and are not yet deleted
+static int access_index(int fifo_index, int window_end){
+  const int count = window_end - fifo_index;
+  if(access_mode == ACCESS_FIFO || count <= 1){
+    return fifo_index;
+  }
+  int age; // 0 is the newest object
+  const double u = erand48(access_seed);
+  if(access_mode == ACCESS_ZIPF){
+    // the first object whose cumulative weight exceeds the drawn weight
+    const double weight = u * zipf_sums[count - 1];
+    int first = 0;
+    int last = count - 1;
+    while(first < last){
+      int mid = (first + last) / 2;
+      if(zipf_sums[mid] > weight){
+        last = mid;
       }else{
-        s->obj_create.err++;
-        if (! o.ignore_precreate_errors){
-          printf("%d: Error while creating the obj: %s\n", o.rank, obj_name);
-          fflush(stdout);
-          MPI_Abort(MPI_COMM_WORLD, 1);
-        }
+        first = mid + 1;
       }
     }
+    age = first;
+  }else{
+    const int hot = (int) ceil(count * access_hot_fraction);
+    if(u < access_hot_probability || hot >= count){
+      age = (int) (erand48(access_seed) * hot);
+    }else{
+      age = hot + (int) (erand48(access_seed) * (count - hot));
+    }
+  }
+  return window_end - 1 - age;
+}
+
+// account the result of an operation in the benchmark phase, for stat the return value indicates if the object should be processed further
+static int check_stat_result(phase_stat_t * s, int ret, char * dset, char * obj_name){
+  if (o.verbosity >= 2){
+    printf("%d: stat %s:%s (%d)\n", o.rank, dset, obj_name, ret);
+  }
+
+  if(ret != MD_SUCCESS && ret != MD_NOOP){
+    if (o.verbosity)
+      printf("%d: Error while stating the obj: %s\n", o.rank, dset);
+    s->obj_stat.err++;
+    return 0;
+  }
+  s->obj_stat.suc++;
+  return 1;
+}
+
+static void check_read_result(phase_stat_t * s, int ret, char * dset, char * obj_name){
+  if (o.verbosity >= 2){
+    printf("%d: read %s:%s (%d)\n", o.rank, dset, obj_name, ret);
+  }
+
+  if (ret == MD_SUCCESS){
+    s->obj_read.suc++;
+  }else if (ret == MD_NOOP){
+    // nothing to do
+  }else if (ret == MD_ERROR_FIND){
+    printf("%d: Error while accessing the file %s (%s)\n", o.rank, dset, strerror(errno));
+    s->obj_read.err++;
+  }else{
+    printf("%d: Error while reading the file %s (%s)\n", o.rank, dset, strerror(errno));
+    s->obj_read.err++;
+  }
+}
+
+static void check_delete_result(phase_stat_t * s, int ret, char * dset, char * obj_name){
+  if (o.verbosity >= 2){
+    printf("%d: delete %s:%s (%d)\n", o.rank, dset, obj_name, ret);
+  }
+
+  if (ret == MD_SUCCESS){
+    s->obj_delete.suc++;
+  }else if (ret == MD_NOOP){
+    // nothing to do
+  }else{
+    printf("%d: Error while deleting the object %s:%s\n", o.rank, dset, obj_name);
+    s->obj_delete.err++;
+  }
+}
+
+static void check_write_result(phase_stat_t * s, int ret, char * dset, char * obj_name){
+  if (o.verbosity >= 2){
+    printf("%d: write %s:%s (%d)\n", o.rank, dset, obj_name, ret);
+  }
+
+  if (ret == MD_SUCCESS){
+      s->obj_create.suc++;
+  }else if (ret == MD_ERROR_CREATE){
+    if (o.verbosity)
+      printf("%d: Error while creating the obj: %s\n",o.rank, dset);
+    s->obj_create.err++;
+  }else if (ret == MD_NOOP){
+      // do not increment any counter
+  }else{
+    if (o.verbosity)
+      printf("%d: Error while writing the obj: %s\n", o.rank, dset);
+    s->obj_create.err++;
   }
-  free(buf);
 }
 
 /* FIFO: create a new file, write to it. Then read from the first created file, delete it... */
 void run_benchmark(phase_stat_t * s, int * current_index_p){
-  char dset[4096];
-  char obj_name[4096];
+  char dset[4096] = "";
+  char obj_name[4096] = "";
   int ret;
-  char * buf = malloc(o.file_size);
-  memset(buf, o.rank % 256, o.file_size);
+  char * buf = alloc_buffer();
   timer op_timer; // timer for individual operations
   size_t pos = -1; // position inside the individual measurement array
   int start_index = *current_index_p;
@@ -636,122 +1855,116 @@ void run_benchmark(phase_stat_t * s, int * current_index_p){
   int armed_stone_wall = (o.stonewall_timer > 0);
   int f;
   double phase_allreduce_time = 0;
+  // the objects written in the current iteration over the data sets
+  size_t * written = (size_t *) malloc(sizeof(size_t) * o.dset_count);
+  int written_count = 0;
 
+  if(o.target_rate > 0){
+    open_loop_init();
+  }
+  rand_init(access_seed, object_seed(o.rank, thread_id, global_iteration) ^ (uint64_t) start_index);
   for(f=0; f < total_num; f++){
     float bench_runtime = 0; // the time since start
-    for(int d=0; d < o.dset_count; d++){
+    for(int d=thread_id; d < o.dset_count; d += o.threads){
       double op_time;
       const int prevFile = f + start_index;
       pos++;
 
-      int readRank = (o.rank - o.offset * (d+1)) % o.size;
-      readRank = readRank < 0 ? readRank + o.size : readRank;
-      ret = o.plugin->def_obj_name(obj_name, readRank, d, prevFile);
+      int readRank = bench_read_rank(d);
+      // the object that is accessed, the oldest object is deleted
+      const int readFile = access_index(prevFile, start_index + o.precreate);
+      ret = define_names(dset, obj_name, readRank, d, readFile);
       if (ret != MD_SUCCESS){
         s->obj_name.err++;
         continue;
       }
-      ret = o.plugin->def_dset_name(dset, readRank, d);
 
+      const size_t read_size = object_size(readRank, d, readFile);
+      if(o.target_rate > 0){
+        open_loop_wait();
+      }
       start_timer(& op_timer);
-      ret = o.plugin->stat_obj(dset, obj_name, o.file_size);
-      bench_runtime = add_timed_result(op_timer, s->phase_start_timer, s->time_stat, pos, & s->max_op_time, & op_time);
+      ret = stat_object(dset, obj_name, readRank, d, readFile, read_size);
+      bench_runtime = add_timed_result(op_timer, s, OP_STAT, s->time_stat, pos, & op_time);
+      add_size_result(s, OP_STAT, read_size, op_time);
       if(o.relative_waiting_factor > 1e-9) {
         wait(op_time);
       }
 
-      if (o.verbosity >= 2){
-        printf("%d: stat %s:%s (%d)\n", o.rank, dset, obj_name, ret);
-      }
-
-      if(ret != MD_SUCCESS && ret != MD_NOOP){
-        if (o.verbosity)
-          printf("%d: Error while stating the obj: %s\n", o.rank, dset);
-        s->obj_stat.err++;
+      if(! check_stat_result(s, ret, dset, obj_name)){
         continue;
       }
-      s->obj_stat.suc++;
 
-      if (o.verbosity >= 2){
-        printf("%d: read %s:%s \n", o.rank, dset, obj_name);
+      evict_object(s, dset, obj_name);
+      if(o.target_rate > 0){
+        open_loop_wait();
       }
-
       start_timer(& op_timer);
-      ret = o.plugin->read_obj(dset, obj_name, buf, o.file_size);
-      bench_runtime = add_timed_result(op_timer, s->phase_start_timer, s->time_read, pos, & s->max_op_time, & op_time);
+      ret = read_object(dset, obj_name, readRank, d, readFile, buf, read_size);
+      bench_runtime = add_timed_result(op_timer, s, OP_READ, s->time_read, pos, & op_time);
+      add_size_result(s, OP_READ, read_size, op_time);
       if(o.relative_waiting_factor > 1e-9) {
         wait(op_time);
       }
-
-      if (ret == MD_SUCCESS){
-        s->obj_read.suc++;
-      }else if (ret == MD_NOOP){
-        // nothing to do
-      }else if (ret == MD_ERROR_FIND){
-        printf("%d: Error while accessing the file %s (%s)\n", o.rank, dset, strerror(errno));
-        s->obj_read.err++;
-      }else{
-        printf("%d: Error while reading the file %s (%s)\n", o.rank, dset, strerror(errno));
-        s->obj_read.err++;
+      check_read_result(s, ret, dset, obj_name);
+      if(ret == MD_SUCCESS){
+        verify_check(s, buf, readRank, d, readFile, obj_name);
       }
 
       if(o.read_only){
         continue;
       }
 
+      if(readFile != prevFile){
+        ret = define_names(dset, obj_name, readRank, d, prevFile);
+        if (ret != MD_SUCCESS){
+          s->obj_name.err++;
+          continue;
+        }
+      }
+
+      if(o.target_rate > 0){
+        open_loop_wait();
+      }
       start_timer(& op_timer);
-      ret = o.plugin->delete_obj(dset, obj_name);
-      bench_runtime = add_timed_result(op_timer, s->phase_start_timer, s->time_delete, pos, & s->max_op_time, & op_time);
+      ret = delete_object(dset, obj_name, readRank, d, prevFile);
+      bench_runtime = add_timed_result(op_timer, s, OP_DELETE, s->time_delete, pos, & op_time);
+      add_size_result(s, OP_DELETE, object_size(readRank, d, prevFile), op_time);
       if(o.relative_waiting_factor > 1e-9) {
         wait(op_time);
       }
-
-      if (o.verbosity >= 2){
-        printf("%d: delete %s:%s (%d)\n", o.rank, dset, obj_name, ret);
-      }
-
-      if (ret == MD_SUCCESS){
-        s->obj_delete.suc++;
-      }else if (ret == MD_NOOP){
-        // nothing to do
-      }else{
-        printf("%d: Error while deleting the object %s:%s\n", o.rank, dset, obj_name);
-        s->obj_delete.err++;
+      check_delete_result(s, ret, dset, obj_name);
+      if(ret == MD_SUCCESS){
+        sync_object(s, dset, obj_name, NULL, 0);
       }
 
-      int writeRank = (o.rank + o.offset * (d+1)) % o.size;
-      ret = o.plugin->def_obj_name(obj_name, writeRank, d, o.precreate + prevFile);
+      int writeRank = bench_write_rank(d);
+      ret = define_names(dset, obj_name, writeRank, d, o.precreate + prevFile);
       if (ret != MD_SUCCESS){
         s->obj_name.err++;
         continue;
       }
-      ret = o.plugin->def_dset_name(dset, writeRank, d);
+      const size_t write_size = object_size(writeRank, d, o.precreate + prevFile);
+      fill_object(s, buf, writeRank, d, o.precreate + prevFile);
 
+      if(o.target_rate > 0){
+        open_loop_wait();
+      }
       start_timer(& op_timer);
-      ret = o.plugin->write_obj(dset, obj_name, buf, o.file_size);
-      bench_runtime = add_timed_result(op_timer, s->phase_start_timer, s->time_create, pos, & s->max_op_time, & op_time);
+      ret = write_object(dset, obj_name, writeRank, d, o.precreate + prevFile, buf, write_size);
+      bench_runtime = add_timed_result(op_timer, s, OP_CREATE, s->time_create, pos, & op_time);
+      add_size_result(s, OP_CREATE, write_size, op_time);
       if(o.relative_waiting_factor > 1e-9) {
         wait(op_time);
       }
-
-      if (o.verbosity >= 2){
-        printf("%d: write %s:%s (%d)\n", o.rank, dset, obj_name, ret);
-      }
-
-      if (ret == MD_SUCCESS){
-          s->obj_create.suc++;
-      }else if (ret == MD_ERROR_CREATE){
-        if (o.verbosity)
-          printf("%d: Error while creating the obj: %s\n",o.rank, dset);
-        s->obj_create.err++;
-      }else if (ret == MD_NOOP){
-          // do not increment any counter
-      }else{
-        if (o.verbosity)
-          printf("%d: Error while writing the obj: %s\n", o.rank, dset);
-        s->obj_create.err++;
+      check_write_result(s, ret, dset, obj_name);
+      if(ret == MD_SUCCESS){
+        sync_object(s, dset, obj_name, s->time_sync, pos);
+        written[written_count++] = pos;
       }
     } // end loop
+    sync_dsets(s, written, written_count);
+    written_count = 0;
 
     if(armed_stone_wall && bench_runtime >= o.stonewall_timer){
       if(o.verbosity){
@@ -784,51 +1997,418 @@ void run_benchmark(phase_stat_t * s, int * current_index_p){
     CHECK_MPI_RET(ret)
     s->stonewall_iterations = total_num;
   }
-  if(o.stonewall_timer && ! o.stonewall_timer_wear_out){
-    // TODO FIXME
-    int sh = s->stonewall_iterations;
-    int ret = MPI_Allreduce(& sh, & s->stonewall_iterations, 1, MPI_INT, MPI_MAX, MPI_COMM_WORLD);
+
+  if(! o.read_only) {
+    *current_index_p += f;
+  }
+  s->repeats = pos + 1;
+  free(written);
+  free_buffer(buf);
+}
+
+// state of a chain of operations on a single object, used with --queue-depth
+typedef enum{
+  CHAIN_FREE = 0,
+  CHAIN_STAT,
+  CHAIN_READ,
+  CHAIN_DELETE,
+  CHAIN_WRITE
+} chain_state_t;
+
+typedef struct{
+  chain_state_t state;
+  size_t pos; // position inside the individual measurement array
+  int d;
+  int file;
+  size_t size; // the size of the object
+  timer op_timer;
+  char * buf;
+  char dset[4096];
+  char obj_name[4096];
+} op_chain_t;
+
+static int submit_chain_op(op_chain_t * c){
+  start_timer(& c->op_timer);
+  switch(c->state){
+    case(CHAIN_STAT):
+      return o.plugin->submit_stat_obj(c, c->dset, c->obj_name, c->size);
+    case(CHAIN_READ):
+      return o.plugin->submit_read_obj(c, c->dset, c->obj_name, c->buf, c->size);
+    case(CHAIN_DELETE):
+      return o.plugin->submit_delete_obj(c, c->dset, c->obj_name);
+    case(CHAIN_WRITE):
+      return o.plugin->submit_write_obj(c, c->dset, c->obj_name, c->buf, c->size);
+    default:
+      return MD_ERROR_UNKNOWN;
+  }
+}
+
+// account the completed operation and submit the next one of the chain, returns 0 if the chain is finished
+static int complete_chain_op(phase_stat_t * s, op_chain_t * c, int ret){
+  while(1){
+    double op_time;
+    chain_state_t next = CHAIN_FREE;
+    switch(c->state){
+      case(CHAIN_STAT):
+        add_timed_result(c->op_timer, s, OP_STAT, s->time_stat, c->pos, & op_time);
+        add_size_result(s, OP_STAT, c->size, op_time);
+        if(check_stat_result(s, ret, c->dset, c->obj_name)){
+          next = CHAIN_READ;
+        }
+        break;
+      case(CHAIN_READ):
+        add_timed_result(c->op_timer, s, OP_READ, s->time_read, c->pos, & op_time);
+        add_size_result(s, OP_READ, c->size, op_time);
+        check_read_result(s, ret, c->dset, c->obj_name);
+        if(! o.read_only){
+          next = CHAIN_DELETE;
+        }
+        break;
+      case(CHAIN_DELETE):{
+        add_timed_result(c->op_timer, s, OP_DELETE, s->time_delete, c->pos, & op_time);
+        add_size_result(s, OP_DELETE, c->size, op_time);
+        check_delete_result(s, ret, c->dset, c->obj_name);
+        int writeRank = bench_write_rank(c->d);
+        if(o.plugin->def_obj_name(c->obj_name, writeRank, c->d, o.precreate + c->file) != MD_SUCCESS){
+          s->obj_name.err++;
+          break;
+        }
+        o.plugin->def_dset_name(c->dset, writeRank, c->d);
+        c->size = object_size(writeRank, c->d, o.precreate + c->file);
+        next = CHAIN_WRITE;
+        break;
+      }case(CHAIN_WRITE):
+        add_timed_result(c->op_timer, s, OP_CREATE, s->time_create, c->pos, & op_time);
+        add_size_result(s, OP_CREATE, c->size, op_time);
+        check_write_result(s, ret, c->dset, c->obj_name);
+        break;
+      default:
+        break;
+    }
+    c->state = next;
+    if(next == CHAIN_FREE){
+      return 0;
+    }
+    ret = submit_chain_op(c);
+    if(ret == MD_SUCCESS){
+      return 1;
+    }
+    // the submission failed, account it as the result of the operation
+  }
+}
+
+/* Same pattern as run_benchmark() but keeps o.queue_depth objects in flight using the asynchronous plugin interface */
+void run_benchmark_async(phase_stat_t * s, int * current_index_p){
+  int ret;
+  int start_index = *current_index_p;
+  int total_num = o.num;
+  int armed_stone_wall = (o.stonewall_timer > 0);
+  double phase_allreduce_time = 0;
+  const int dset_count = thread_dset_count(thread_id);
+  size_t next_item = 0; // the next (file, dset) tuple to process
+  size_t last_item = (size_t) total_num * dset_count;
+  int f = 0;
+  int active = 0;
+
+  op_chain_t * chains = malloc(sizeof(op_chain_t) * o.queue_depth);
+  for(int i=0; i < o.queue_depth; i++){
+    chains[i].state = CHAIN_FREE;
+    chains[i].buf = alloc_buffer();
+  }
+
+  while(1){
+    // start new chains on all free slots
+    for(int i=0; i < o.queue_depth && next_item < last_item; i++){
+      op_chain_t * c = & chains[i];
+      if(c->state != CHAIN_FREE){
+        continue;
+      }
+      f = next_item / dset_count;
+      int d = thread_id + (next_item % dset_count) * o.threads;
+      if(next_item % dset_count == 0 && armed_stone_wall){
+        double bench_runtime = stop_timer(s->phase_start_timer);
+        if(bench_runtime >= o.stonewall_timer){
+          if(o.verbosity){
+            printf("%d: stonewall runtime %fs (%ds)\n", o.rank, bench_runtime, o.stonewall_timer);
+          }
+          armed_stone_wall = 0;
+          if(! o.stonewall_timer_wear_out){
+            s->stonewall_iterations = f;
+            last_item = next_item;
+            break;
+          }
+          // wear out mode, now reduce the maximum
+          phase_allreduce_time = stop_timer(s->phase_start_timer);
+          ret = MPI_Allreduce(& f, & total_num, 1, MPI_INT, MPI_MAX, MPI_COMM_WORLD);
+          start_timer(& s->phase_start_timer);
+          CHECK_MPI_RET(ret)
+          s->stonewall_iterations = total_num;
+          if(o.rank == 0){
+            printf("stonewall wear out %fs (%d iter)\n", bench_runtime, total_num);
+          }
+          last_item = (size_t) total_num * dset_count;
+          if(next_item >= last_item){
+            break;
+          }
+        }
+      }
+      c->pos = next_item;
+      c->d = d;
+      c->file = f + start_index;
+      next_item++;
+
+      int readRank = bench_read_rank(d);
+      if(o.plugin->def_obj_name(c->obj_name, readRank, d, c->file) != MD_SUCCESS){
+        s->obj_name.err++;
+        i--; // try the next object on the same slot
+        continue;
+      }
+      o.plugin->def_dset_name(c->dset, readRank, d);
+      c->size = object_size(readRank, d, c->file);
+      c->state = CHAIN_STAT;
+      active++;
+      ret = submit_chain_op(c);
+      if(ret != MD_SUCCESS && ! complete_chain_op(s, c, ret)){
+        active--;
+        i--;
+      }
+    }
+    if(active == 0){
+      break;
+    }
+
+    void * tag;
+    int op_ret;
+    ret = o.plugin->poll_obj(& tag, & op_ret);
+    if(ret != MD_SUCCESS){
+      printf("%d: Error while waiting for asynchronous operations (%d outstanding)\n", o.rank, active);
+      MPI_Abort(MPI_COMM_WORLD, 1);
+    }
+    if(! complete_chain_op(s, (op_chain_t *) tag, op_ret)){
+      active--;
+    }
+  }
+  f = dset_count > 0 ? (int) ((next_item + dset_count - 1) / dset_count) : total_num;
+
+  s->t = stop_timer(s->phase_start_timer) + phase_allreduce_time;
+  if(armed_stone_wall && o.stonewall_timer_wear_out){
+    ret = MPI_Allreduce(& f, & total_num, 1, MPI_INT, MPI_MAX, MPI_COMM_WORLD);
     CHECK_MPI_RET(ret)
+    s->stonewall_iterations = total_num;
   }
 
   if(! o.read_only) {
     *current_index_p += f;
   }
-  s->repeats = pos + 1;
-  free(buf);
+  s->repeats = next_item;
+  for(int i=0; i < o.queue_depth; i++){
+    free_buffer(chains[i].buf);
+  }
+  free(chains);
 }
 
-void run_cleanup(phase_stat_t * s, int start_index){
+// stat, read, delete and recreate the objects of the batch
+static void benchmark_batch(phase_stat_t * s, obj_batch_t * b, char * buf){
+  batch_run(s, b, OP_STAT, s->time_stat, buf);
+  for(int i=0; i < b->count; i++){
+    b->ret[i] = check_stat_result(s, b->ret[i], b->dsets[i], b->names[i]);
+  }
+  batch_compact(b);
+  if(b->count == 0){
+    return;
+  }
+
+  batch_run(s, b, OP_READ, s->time_read, buf);
+  for(int i=0; i < b->count; i++){
+    check_read_result(s, b->ret[i], b->dsets[i], b->names[i]);
+  }
+  if(o.read_only){
+    batch_clear(b);
+    return;
+  }
+
+  batch_run(s, b, OP_DELETE, s->time_delete, buf);
+  for(int i=0; i < b->count; i++){
+    check_delete_result(s, b->ret[i], b->dsets[i], b->names[i]);
+    int writeRank = bench_write_rank(b->d[i]);
+    b->ret[i] = o.plugin->def_obj_name(b->names[i], writeRank, b->d[i], o.precreate + b->file[i]) == MD_SUCCESS;
+    if(! b->ret[i]){
+      s->obj_name.err++;
+      continue;
+    }
+    o.plugin->def_dset_name(b->dsets[i], writeRank, b->d[i]);
+  }
+  batch_compact(b);
+  if(b->count == 0){
+    return;
+  }
+
+  batch_run(s, b, OP_CREATE, s->time_create, buf);
+  for(int i=0; i < b->count; i++){
+    check_write_result(s, b->ret[i], b->dsets[i], b->names[i]);
+  }
+  batch_clear(b);
+}
+
+/* Same pattern as run_benchmark() but processes o.batch_size objects at once using the batched plugin interface.
+ * Each round covers up to o.batch_size iterations and fills one batch per data set, so a batch never mixes data sets */
+void run_benchmark_batch(phase_stat_t * s, int * current_index_p){
   char dset[4096];
   char obj_name[4096];
   int ret;
+  char * buf = alloc_buffer();
+  int start_index = *current_index_p;
+  int total_num = o.num;
+  int armed_stone_wall = (o.stonewall_timer > 0);
+  double phase_allreduce_time = 0;
+  const int dset_count = thread_dset_count(thread_id);
+  // a round must not read objects it creates itself
+  const int round = o.precreate < o.batch_size ? (o.precreate > 0 ? o.precreate : 1) : o.batch_size;
+  int f = 0; // the first iteration of the current round
+  obj_batch_t * b = batch_alloc();
+
+  while(f < total_num){
+    if(armed_stone_wall){
+      double bench_runtime = stop_timer(s->phase_start_timer);
+      if(bench_runtime >= o.stonewall_timer){
+        if(o.verbosity){
+          printf("%d: stonewall runtime %fs (%ds)\n", o.rank, bench_runtime, o.stonewall_timer);
+        }
+        armed_stone_wall = 0;
+        // the previous rounds are complete
+        if(! o.stonewall_timer_wear_out){
+          s->stonewall_iterations = f;
+          break;
+        }
+        // wear out mode, now reduce the maximum
+        phase_allreduce_time = stop_timer(s->phase_start_timer);
+        ret = MPI_Allreduce(& f, & total_num, 1, MPI_INT, MPI_MAX, MPI_COMM_WORLD);
+        start_timer(& s->phase_start_timer);
+        CHECK_MPI_RET(ret)
+        s->stonewall_iterations = total_num;
+        if(o.rank == 0){
+          printf("stonewall wear out %fs (%d iter)\n", bench_runtime, total_num);
+        }
+        if(f >= total_num){
+          break;
+        }
+      }
+    }
+
+    const int f_end = f + round < total_num ? f + round : total_num;
+    for(int d=thread_id; d < o.dset_count; d += o.threads){
+      int readRank = bench_read_rank(d);
+      o.plugin->def_dset_name(dset, readRank, d);
+      for(int i=f; i < f_end; i++){
+        size_t pos = (size_t) i * dset_count + (d - thread_id) / o.threads;
+        ret = o.plugin->def_obj_name(obj_name, readRank, d, i + start_index);
+        if (ret != MD_SUCCESS){
+          s->obj_name.err++;
+          continue;
+        }
+        batch_add(b, dset, obj_name, pos, d, i + start_index);
+      }
+      benchmark_batch(s, b, buf);
+    }
+    f = f_end;
+  }
+
+  s->t = stop_timer(s->phase_start_timer) + phase_allreduce_time;
+  if(armed_stone_wall && o.stonewall_timer_wear_out){
+    ret = MPI_Allreduce(& f, & total_num, 1, MPI_INT, MPI_MAX, MPI_COMM_WORLD);
+    CHECK_MPI_RET(ret)
+    s->stonewall_iterations = total_num;
+  }
+
+  if(! o.read_only) {
+    *current_index_p += f;
+  }
+  s->repeats = (size_t) f * dset_count;
+  batch_free(b);
+  free_buffer(buf);
+}
+
+static void check_cleanup_result(phase_stat_t * s, int ret, char * dset, char * obj_name){
+  if (o.verbosity >= 2){
+    printf("%d: delete %s:%s (%d)\n", o.rank, dset, obj_name, ret);
+  }
+
+  if (ret == MD_NOOP){
+    // nothing to do
+  }else if (ret == MD_SUCCESS){
+    s->obj_delete.suc++;
+  }else if(ret != MD_NOOP){
+    s->obj_delete.err++;
+  }
+}
+
+static void cleanup_batch(phase_stat_t * s, obj_batch_t * b){
+  if(b->count == 0){
+    return;
+  }
+  batch_run(s, b, OP_DELETE, s->time_delete, NULL);
+  for(int i=0; i < b->count; i++){
+    check_cleanup_result(s, b->ret[i], b->dsets[i], b->names[i]);
+  }
+  batch_clear(b);
+}
+
+void run_cleanup(phase_stat_t * s, int start_index){
+  char dset[4096] = "";
+  char obj_name[4096] = "";
+  int ret;
   timer op_timer; // timer for individual operations
   size_t pos = -1; // position inside the individual measurement array
+  obj_batch_t * batch = o.batch_size > 1 && o.plugin->delete_objs ? batch_alloc() : NULL;
+  const int bulk = o.bulk && o.plugin->bulk_delete_objs;
 
-  for(int d=0; d < o.dset_count; d++){
+  for(int d=thread_id; d < o.dset_count; d += o.threads){
+    int deleted = 0;
     ret = o.plugin->def_dset_name(dset, o.rank, d);
 
-    for(int f=0; f < o.precreate; f++){
+    if (bulk){
+      int count;
+      start_timer(& op_timer);
+      ret = o.plugin->bulk_delete_objs(dset, o.rank, d, start_index, start_index + o.precreate, & count);
+      add_bulk_result(op_timer, s);
+      if (o.verbosity >= 2){
+        printf("%d: bulk delete %s (%d objs, %d)\n", o.rank, dset, count, ret);
+      }
+      s->obj_delete.suc += count;
+      if (ret != MD_SUCCESS){
+        s->obj_delete.err += o.precreate - count;
+      }
+      deleted = count;
+    }
+
+    for(int f=0; f < o.precreate && ! bulk; f++){
       double op_time;
       pos++;
-      ret = o.plugin->def_obj_name(obj_name, o.rank, d, f + start_index);
+      ret = obj_names ? o.plugin->def_obj_name(obj_name, o.rank, d, f + start_index) : MD_SUCCESS;
 
-      start_timer(& op_timer);
-      ret = o.plugin->delete_obj(dset, obj_name);
-      add_timed_result(op_timer, s->phase_start_timer, s->time_delete, pos, & s->max_op_time, & op_time);
-
-      if (o.verbosity >= 2){
-        printf("%d: delete %s:%s (%d)\n", o.rank, dset, obj_name, ret);
+      if (batch){
+        batch_add(batch, dset, obj_name, pos, d, f + start_index);
+        if (batch->count == o.batch_size){
+          cleanup_batch(s, batch);
+        }
+        continue;
       }
 
-      if (ret == MD_NOOP){
-        // nothing to do
-      }else if (ret == MD_SUCCESS){
-        s->obj_delete.suc++;
-      }else if(ret != MD_NOOP){
-        s->obj_delete.err++;
+      start_timer(& op_timer);
+      ret = delete_object(dset, obj_name, o.rank, d, f + start_index);
+      add_timed_result(op_timer, s, OP_DELETE, s->time_delete, pos, & op_time);
+      add_size_result(s, OP_DELETE, object_size(o.rank, d, f + start_index), op_time);
+      check_cleanup_result(s, ret, dset, obj_name);
+      if (ret == MD_SUCCESS){
+        sync_object(s, dset, obj_name, NULL, 0);
+        deleted++;
       }
     }
+    if (batch){
+      // the objects must be removed before the data set
+      cleanup_batch(s, batch);
+    }
+    sync_dsets(s, NULL, deleted);
 
     ret = o.plugin->rm_dset(dset);
 
@@ -842,8 +2422,246 @@ void run_cleanup(phase_stat_t * s, int start_index){
       s->dset_delete.err++;
     }
   }
+  if (batch){
+    batch_free(batch);
+  }
+  if (bulk){
+    // no individual measurements
+    s->repeats = 0;
+  }
+}
+
+typedef enum{
+  PHASE_NONE = 0,
+  PHASE_PRECREATE,
+  PHASE_BENCHMARK,
+  PHASE_CLEANUP
+} phase_t;
+
+static int use_async_benchmark();
+static int use_batch_benchmark();
+
+// runs the phase on the data sets of the calling thread
+static void run_phase_thread(phase_t phase, phase_stat_t * s, int * current_index_p){
+  switch(phase){
+    case(PHASE_PRECREATE):
+      run_precreate(s, *current_index_p);
+      break;
+    case(PHASE_BENCHMARK):
+      if(use_async_benchmark()){
+        run_benchmark_async(s, current_index_p);
+      }else if(use_batch_benchmark()){
+        run_benchmark_batch(s, current_index_p);
+      }else{
+        run_benchmark(s, current_index_p);
+      }
+      break;
+    case(PHASE_CLEANUP):
+      run_cleanup(s, *current_index_p);
+      break;
+    default:
+      break;
+  }
+}
+
+// the state of a thread used with --threads-per-rank, thread 0 is the main thread
+typedef struct{
+  pthread_t thread;
+  int id;
+  int ret; // the result of initializing the plugin
+  int current_index;
+  phase_stat_t stats;
+} thread_state_t;
+
+static thread_state_t * threads = NULL;
+static pthread_barrier_t thread_barrier;
+static phase_t thread_phase = PHASE_NONE;
+
+static void * thread_main(void * arg){
+  thread_state_t * t = (thread_state_t *) arg;
+  thread_id = t->id;
+  t->ret = o.plugin->thread_initialize();
+  pthread_barrier_wait(& thread_barrier);
+  if(t->ret != MD_SUCCESS){
+    return NULL;
+  }
+
+  while(1){
+    pthread_barrier_wait(& thread_barrier);
+    if(thread_phase == PHASE_NONE){
+      break;
+    }
+    run_phase_thread(thread_phase, & t->stats, & t->current_index);
+    pthread_barrier_wait(& thread_barrier);
+  }
+  o.plugin->thread_finalize();
+  return NULL;
+}
+
+static void start_threads(){
+  threads = calloc(o.threads, sizeof(thread_state_t));
+  pthread_barrier_init(& thread_barrier, NULL, o.threads);
+  for(int i=1; i < o.threads; i++){
+    threads[i].id = i;
+    if(pthread_create(& threads[i].thread, NULL, thread_main, & threads[i]) != 0){
+      printf("%d: Error creating thread %d\n", o.rank, i);
+      MPI_Abort(MPI_COMM_WORLD, 1);
+    }
+  }
+  pthread_barrier_wait(& thread_barrier);
+  for(int i=1; i < o.threads; i++){
+    if(threads[i].ret != MD_SUCCESS){
+      printf("%d: Error initializing module in thread %d\n", o.rank, i);
+      MPI_Abort(MPI_COMM_WORLD, 1);
+    }
+  }
+}
+
+static void stop_threads(){
+  thread_phase = PHASE_NONE;
+  pthread_barrier_wait(& thread_barrier);
+  for(int i=1; i < o.threads; i++){
+    pthread_join(threads[i].thread, NULL);
+  }
+  pthread_barrier_destroy(& thread_barrier);
+  free(threads);
+  threads = NULL;
+}
+
+// add the statistics of a thread to the statistics of the process
+static void merge_thread_stats(phase_stat_t * p, phase_stat_t * t){
+  p->t = t->t > p->t ? t->t : p->t;
+  p->max_op_time = t->max_op_time > p->max_op_time ? t->max_op_time : p->max_op_time;
+  p->stonewall_iterations = t->stonewall_iterations > p->stonewall_iterations ? t->stonewall_iterations : p->stonewall_iterations;
+  p->bulk_ops += t->bulk_ops;
+  p->bulk_time += t->bulk_time;
+  p->bulk_max_time = t->bulk_max_time > p->bulk_max_time ? t->bulk_max_time : p->bulk_max_time;
+  p->evict_ops += t->evict_ops;
+  p->evict_time += t->evict_time;
+  p->verify_ops += t->verify_ops;
+  p->verify_time += t->verify_time;
+  for(int op=0; op < OP_TYPES; op++){
+    for(int b=0; b < SIZE_BUCKETS; b++){
+      p->size_ops[op][b] += t->size_ops[op][b];
+      p->size_time[op][b] += t->size_time[op][b];
+      p->size_max_time[op][b] = t->size_max_time[op][b] > p->size_max_time[op][b] ? t->size_max_time[op][b] : p->size_max_time[op][b];
+    }
+  }
+  // the operation counters are stored consecutively, see end_phase()
+  op_stat_t * p_op = & p->dset_name;
+  op_stat_t * t_op = & t->dset_name;
+  for(int i=0; i < 3+7; i++){
+    p_op[i].suc += t_op[i].suc;
+    p_op[i].err += t_op[i].err;
+  }
+  for(int i=0; i < hist_count(); i++){
+    histogram_merge(& p->hist[i], & t->hist[i]);
+  }
+  if(p->time_create && t->time_create){
+    size_t timer_size = t->repeats * sizeof(time_result_t);
+    memcpy(p->time_create + p->repeats, t->time_create, timer_size);
+    memcpy(p->time_read + p->repeats, t->time_read, timer_size);
+    memcpy(p->time_stat + p->repeats, t->time_stat, timer_size);
+    memcpy(p->time_delete + p->repeats, t->time_delete, timer_size);
+    memcpy(p->time_sync + p->repeats, t->time_sync, timer_size);
+  }
+  p->repeats += t->repeats;
+  free_stats(t);
 }
 
+static void run_phase(phase_t phase, phase_stat_t * s, int * current_index_p){
+  uint64_t connections_start = 0;
+  const int count_connections = o.plugin->connection_count && o.plugin->connection_count(& connections_start) == MD_SUCCESS;
+
+  interval_begin(phase == PHASE_PRECREATE ? "precreate" : (phase == PHASE_BENCHMARK ? "benchmark" : "cleanup"));
+  if(o.threads == 1){
+    run_phase_thread(phase, s, current_index_p);
+  }else{
+    size_t repeats = phase == PHASE_BENCHMARK ? o.num : o.precreate;
+    for(int i=0; i < o.threads; i++){
+      thread_state_t * t = & threads[i];
+      init_stats(& t->stats, repeats * thread_dset_count(i));
+      t->stats.phase_start_timer = s->phase_start_timer;
+      t->current_index = *current_index_p;
+    }
+    thread_phase = phase;
+    pthread_barrier_wait(& thread_barrier);
+    run_phase_thread(phase, & threads[0].stats, & threads[0].current_index);
+    pthread_barrier_wait(& thread_barrier);
+
+    s->repeats = 0;
+    for(int i=0; i < o.threads; i++){
+      merge_thread_stats(s, & threads[i].stats);
+    }
+    *current_index_p = threads[0].current_index;
+  }
+  interval_end();
+
+  s->connections = -1;
+  if(count_connections){
+    uint64_t connections_end = connections_start;
+    o.plugin->connection_count(& connections_end);
+    s->connections = (int) (connections_end - connections_start);
+  }
+
+  if(phase == PHASE_BENCHMARK && o.stonewall_timer && ! o.stonewall_timer_wear_out){
+    // TODO FIXME
+    int sh = s->stonewall_iterations;
+    int ret = MPI_Allreduce(& sh, & s->stonewall_iterations, 1, MPI_INT, MPI_MAX, MPI_COMM_WORLD);
+    CHECK_MPI_RET(ret)
+  }
+}
+
+// evict the objects accessed in the next phase from the caches with --cold-cache, the time is reported separately
+static void evict_phase(phase_t phase, int current_index){
+  char dset[4096];
+  char obj_name[4096];
+  int ret;
+  int counts[2] = {0, 0}; // evicted objects, errors
+  // with --access, the benchmark reads any object of the live window
+  const int count = phase == PHASE_BENCHMARK && access_mode == ACCESS_FIFO ? o.num : o.precreate;
+
+  MPI_Barrier(MPI_COMM_WORLD);
+  timer evict_timer;
+  start_timer(& evict_timer);
+  for(int f=0; f < count && o.plugin->evict_obj; f++){
+    for(int d=0; d < o.dset_count; d++){
+      // the benchmark reads the objects of another process
+      const int rank = phase == PHASE_BENCHMARK ? bench_read_rank(d) : o.rank;
+      if(o.plugin->def_obj_name(obj_name, rank, d, current_index + f) != MD_SUCCESS){
+        continue;
+      }
+      o.plugin->def_dset_name(dset, rank, d);
+      ret = o.plugin->evict_obj(dset, obj_name);
+      if(ret == MD_SUCCESS){
+        counts[0]++;
+      }else if(ret != MD_NOOP){
+        counts[1]++;
+      }
+    }
+  }
+  // the caches of a node are dropped once its processes evicted their objects
+  int node_rank;
+  MPI_Comm_rank(node_comm, & node_rank);
+  MPI_Barrier(node_comm);
+  if(node_rank == 0 && o.plugin->evict_caches){
+    ret = o.plugin->evict_caches();
+    if(ret != MD_SUCCESS && ret != MD_NOOP){
+      counts[1]++;
+    }
+  }
+  double t = stop_timer(evict_timer);
+
+  double t_max;
+  int g_counts[2];
+  ret = MPI_Reduce(& t, & t_max, 1, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD);
+  CHECK_MPI_RET(ret)
+  ret = MPI_Reduce(counts, g_counts, 2, MPI_INT, MPI_SUM, 0, MPI_COMM_WORLD);
+  CHECK_MPI_RET(ret)
+  if(o.rank == 0){
+    printf("evict process max:%.4fs objects:%d (%d errs%s)\n", t_max, g_counts[0], g_counts[1], g_counts[1] > 0 ? "!!!" : "");
+  }
+}
 
 static option_help options [] = {
   {'O', "offset", "Offset in o.ranks between writers and readers. Writers and readers should be located on different nodes.", OPTION_OPTIONAL_ARGUMENT, 'd', & o.offset},
@@ -851,6 +2669,7 @@ static option_help options [] = {
   {'I', "obj-per-proc", "Number of I/O operations per data set.", OPTION_OPTIONAL_ARGUMENT, 'd', & o.num},
   {'L', "latency", "Measure the latency for individual operations, prefix the result files with the provided filename.", OPTION_OPTIONAL_ARGUMENT, 's', & o.latency_file_prefix},
   {0, "latency-all", "Keep the latency files from all ranks.", OPTION_FLAG, 'd', & o.latency_keep_all},
+  {0, "latency-format", "The format of the latency files: csv (one file per operation), binary (one file per phase, see read-latency-file.py) or mpiio (one file per operation written collectively by all ranks)", OPTION_OPTIONAL_ARGUMENT, 's', & o.latency_format},
   {'P', "precreate-per-set", "Number of object to precreate per data set.", OPTION_OPTIONAL_ARGUMENT, 'd', & o.precreate},
   {'D', "data-sets", "Number of data sets covered per process and iteration.", OPTION_OPTIONAL_ARGUMENT, 'd', & o.dset_count},
   {'q', "quiet", "Avoid irrelevant printing.", OPTION_FLAG, 'd', & o.quiet_output},
@@ -865,6 +2684,23 @@ static option_help options [] = {
   {'3', "run-cleanup", "Run cleanup phase (only run explicit phases)", OPTION_FLAG, 'd', & o.phase_cleanup},
   {'w', "stonewall-timer", "Stop each benchmark iteration after the specified seconds (if not used with -W this leads to process-specific progress!)", OPTION_OPTIONAL_ARGUMENT, 'd', & o.stonewall_timer},
   {'W', "stonewall-wear-out", "Stop with stonewall after specified time and use a soft wear-out phase -- all processes perform the same number of iterations", OPTION_FLAG, 'd', & o.stonewall_timer_wear_out},
+  {0, "queue-depth", "Number of objects processed concurrently per process in the benchmark phase, needs a plugin with asynchronous support; the waiting time is not applied", OPTION_OPTIONAL_ARGUMENT, 'd', & o.queue_depth},
+  {0, "batch-size", "Number of objects passed at once to a plugin with a batched interface; the runtime of a batch is accounted equally to its operations, the waiting time is not applied", OPTION_OPTIONAL_ARGUMENT, 'd', & o.batch_size},
+  {0, "bulk", "Precreate and clean up the objects of each data set with a single bulk operation if the plugin supports it, the bulk operations are reported separately", OPTION_FLAG, 'd', & o.bulk},
+  {0, "hugepages", "Allocate the I/O buffers from huge pages, the buffers are always aligned and padded to 4 KiB, e.g., for O_DIRECT", OPTION_FLAG, 'd', & o.hugepages},
+  {0, "cold-cache", "Evict the objects from the caches of the client before each benchmark iteration and the cleanup if the plugin supports it, the eviction is reported separately", OPTION_FLAG, 'd', & o.cold_cache},
+  {0, "cold-cache-reads", "Evict each object from the caches of the client before it is read, the eviction is not part of the read time", OPTION_FLAG, 'd', & o.cold_cache_reads},
+  {0, "payload", "The content of the objects: rank (the rank repeated), zero, random, compressible:RATIO or dedup:PERCENT of the 4 KiB blocks, except for rank the content is unique per object", OPTION_OPTIONAL_ARGUMENT, 's', & o.payload},
+  {0, "verify", "Write a pattern derived from the object and verify it on read, the verification is reported separately", OPTION_FLAG, 'd', & o.verify},
+  {0, "size-dist", "The distribution of the object sizes: fixed (the object size), uniform:MIN:MAX, lognormal:MEDIAN:SIGMA limited to the object size or cdf:FILE with lines of the size and the cumulative fraction of the objects; the size is deterministic per object and the latency is reported per power-of-two size range", OPTION_OPTIONAL_ARGUMENT, 's', & o.size_dist},
+  {0, "access", "The objects stated and read in the benchmark phase: fifo (the oldest object), zipf:THETA (zipfian over the live objects, the newest is the most popular) or hotset:PERCENT:PROBABILITY (the newest PERCENT of the live objects are accessed with PROBABILITY in percent); the oldest object is still deleted", OPTION_OPTIONAL_ARGUMENT, 's', & o.access},
+  {0, "shuffle-ranks", "Apply the offset between writers and readers to a random permutation of the ranks that changes with each iteration", OPTION_FLAG, 'd', & o.shuffle_ranks},
+  {0, "seed", "The seed for the random choices, e.g., of --access, --shuffle-ranks and the poisson arrivals", OPTION_OPTIONAL_ARGUMENT, 'd', & o.seed},
+  {0, "threads-per-rank", "Number of threads per process, each thread processes its own subset of the data sets", OPTION_OPTIONAL_ARGUMENT, 'd', & o.threads},
+  {0, "target-rate", "Scheduled-start (wrk2-style) pacing: schedule the operations of the benchmark phase at this rate (iops/s across all processes) and measure the latency from the scheduled start, the response times then include the queuing delay", OPTION_OPTIONAL_ARGUMENT, 'f', & o.target_rate},
+  {0, "target-rate-per-rank", "The target rate is given per process", OPTION_FLAG, 'd', & o.target_rate_per_rank},
+  {0, "arrival", "The arrival process for the target rate: fixed or poisson", OPTION_OPTIONAL_ARGUMENT, 's', & o.arrival},
+  {0, "report-interval", "Report the rate and latency of the operations of all processes periodically during each phase (seconds)", OPTION_OPTIONAL_ARGUMENT, 'f', & o.report_interval},
   {0, "start-item", "The iteration number of the item to start with, allowing to offset the operations", OPTION_OPTIONAL_ARGUMENT, 'l', & o.start_item_number},
   {0, "print-detailed-stats", "Print detailed machine parsable statistics.", OPTION_FLAG, 'd', & o.print_detailed_stats},
   {0, "read-only", "Run read-only during benchmarking phase (no deletes/writes), probably use with -2", OPTION_FLAG, 'd', & o.read_only},
@@ -875,6 +2711,14 @@ static option_help options [] = {
   LAST_OPTION
   };
 
+static int use_async_benchmark(){
+  return o.queue_depth > 1 && o.plugin->submit_stat_obj && o.plugin->submit_read_obj && o.plugin->submit_delete_obj && o.plugin->submit_write_obj && o.plugin->poll_obj;
+}
+
+static int use_batch_benchmark(){
+  return o.batch_size > 1 && o.plugin->write_objs && o.plugin->read_objs && o.plugin->stat_objs && o.plugin->delete_objs;
+}
+
 static void find_interface(){
   int is_list = strcmp(o.interface, "list") == 0 && o.rank == 0;
   if (is_list){
@@ -954,10 +2798,25 @@ int main(int argc, char ** argv){
 
   init_options();
 
-  MPI_Init(& argc, & argv);
+  int thread_support;
+  MPI_Init_thread(& argc, & argv, MPI_THREAD_FUNNELED, & thread_support);
   MPI_Comm_rank(MPI_COMM_WORLD, & o.rank);
   MPI_Comm_size(MPI_COMM_WORLD, & o.size);
 
+  MPI_Type_contiguous(sizeof(histogram_t), MPI_BYTE, & histogram_type);
+  MPI_Type_commit(& histogram_type);
+  MPI_Op_create(histogram_reduce_op, 1, & histogram_op);
+  MPI_Type_contiguous(2, MPI_FLOAT, & time_result_type);
+  MPI_Type_commit(& time_result_type);
+  MPI_Comm_split_type(MPI_COMM_WORLD, MPI_COMM_TYPE_SHARED, o.rank, MPI_INFO_NULL, & node_comm);
+  int node_rank;
+  MPI_Comm_rank(node_comm, & node_rank);
+  MPI_Comm_split(MPI_COMM_WORLD, node_rank == 0 ? 0 : MPI_UNDEFINED, o.rank, & leader_comm);
+  MPI_Comm_dup(MPI_COMM_WORLD, & interval_comm);
+  MPI_Type_contiguous(sizeof(interval_stat_t), MPI_BYTE, & interval_type);
+  MPI_Type_commit(& interval_type);
+  MPI_Op_create(interval_reduce_op, 1, & interval_op);
+
   if (o.rank == 0 && ! o.quiet_output){
     printf("Args: %s", argv[0]);
     for(int i=1; i < argc; i++){
@@ -999,11 +2858,168 @@ int main(int argc, char ** argv){
     exit(1);
   }
 
+  if (strcmp(o.latency_format, "csv") != 0 && strcmp(o.latency_format, "binary") != 0 && strcmp(o.latency_format, "mpiio") != 0){
+    if(o.rank == 0)
+      printf("Invalid options, unknown latency format: %s\n", o.latency_format);
+    exit(1);
+  }
+
+  if (o.target_rate < 0 || (strcmp(o.arrival, "fixed") != 0 && strcmp(o.arrival, "poisson") != 0)){
+    if(o.rank == 0)
+      printf("Invalid options, the target rate must be positive and the arrival process fixed or poisson\n");
+    exit(1);
+  }
+  if (o.target_rate > 0 && o.queue_depth > 1){
+    if(o.rank == 0)
+      printf("Invalid options, the target rate cannot be used together with a queue depth\n");
+    exit(1);
+  }
+  if (o.target_rate > 0 && (o.relative_waiting_factor > 1e-9 || o.adaptive_waiting_mode)){
+    if(o.rank == 0)
+      printf("Invalid options, the target rate cannot be used together with a waiting time\n");
+    exit(1);
+  }
+
+  if (o.report_interval < 0 || (o.report_interval > 0 && o.threads > 1)){
+    if(o.rank == 0)
+      printf("Invalid options, the report interval must be positive and cannot be used with multiple threads per rank\n");
+    exit(1);
+  }
+
+  if (o.queue_depth < 1){
+    if(o.rank == 0)
+      printf("Invalid options, the queue depth must be at least 1\n");
+    exit(1);
+  }
+  if (o.queue_depth > 1 && ! use_async_benchmark() && o.rank == 0){
+    printf("WARNING: plugin %s does not support asynchronous operations, running the benchmark with a queue depth of 1\n", o.plugin->name);
+  }
+
+  if (o.batch_size < 1){
+    if(o.rank == 0)
+      printf("Invalid options, the batch size must be at least 1\n");
+    exit(1);
+  }
+  if (o.batch_size > 1 && (o.queue_depth > 1 || o.target_rate > 0)){
+    if(o.rank == 0)
+      printf("Invalid options, the batch size cannot be used together with a queue depth or a target rate\n");
+    exit(1);
+  }
+  if (o.batch_size > 1 && ! use_batch_benchmark() && o.rank == 0){
+    printf("WARNING: plugin %s does not support batched operations, running the benchmark without batches\n", o.plugin->name);
+  }
+
+  if (o.bulk && ! o.plugin->bulk_create_objs && ! o.plugin->bulk_delete_objs && o.rank == 0){
+    printf("WARNING: plugin %s does not support bulk operations\n", o.plugin->name);
+  }
+
+  if (o.verify && (o.batch_size > 1 || o.queue_depth > 1 || o.bulk)){
+    if(o.rank == 0)
+      printf("Invalid options, --verify cannot be used together with a batch size, a queue depth or bulk operations\n");
+    exit(1);
+  }
+
+  if (strcmp(o.payload, "rank") != 0){
+    if (payload_parse(& payload, o.payload) != 0){
+      if(o.rank == 0)
+        printf("Invalid options, unknown payload: %s\n", o.payload);
+      exit(1);
+    }
+    payload_enabled = 1;
+  }else if (o.verify){
+    // the rank is not unique per object
+    payload_parse(& payload, "random");
+    payload_enabled = 1;
+  }
+
+  if (strcmp(o.size_dist, "fixed") != 0){
+    if (size_dist_parse(& size_dist, o.size_dist, o.file_size) != 0 || size_dist.max > INT_MAX){
+      if(o.rank == 0)
+        printf("Invalid options, unknown or invalid size distribution: %s\n", o.size_dist);
+      exit(1);
+    }
+    if (o.batch_size > 1 || o.bulk){
+      if(o.rank == 0)
+        printf("Invalid options, --size-dist cannot be used together with a batch size or bulk operations\n");
+      exit(1);
+    }
+    // the I/O buffers hold the largest object
+    o.file_size = (int) size_dist.max;
+    size_dist_enabled = 1;
+  }
+
+  if (strcmp(o.access, "fifo") != 0){
+    double a, b;
+    if (sscanf(o.access, "zipf:%lf", & a) == 1 && a > 0){
+      access_mode = ACCESS_ZIPF;
+      access_theta = a;
+    }else if (sscanf(o.access, "hotset:%lf:%lf", & a, & b) == 2 && a > 0 && a <= 100 && b >= 0 && b <= 100){
+      access_mode = ACCESS_HOTSET;
+      access_hot_fraction = a / 100;
+      access_hot_probability = b / 100;
+    }else{
+      if(o.rank == 0)
+        printf("Invalid options, unknown access pattern: %s\n", o.access);
+      exit(1);
+    }
+    if (o.batch_size > 1 || o.queue_depth > 1){
+      if(o.rank == 0)
+        printf("Invalid options, --access cannot be used together with a batch size or a queue depth\n");
+      exit(1);
+    }
+    if (access_mode == ACCESS_ZIPF && o.precreate > 0){
+      zipf_sums = (double *) malloc(sizeof(double) * o.precreate);
+      double sum = 0;
+      for(int i=0; i < o.precreate; i++){
+        sum += 1 / pow(i + 1, access_theta);
+        zipf_sums[i] = sum;
+      }
+    }
+  }
+
+  obj_ids = o.plugin->write_obj_id && o.plugin->read_obj_id && o.plugin->stat_obj_id && o.plugin->delete_obj_id;
+  // the names are passed to the batched interface, the durability and eviction hooks and printed
+  obj_names = ! obj_ids || o.batch_size > 1 || o.plugin->sync_obj || (o.cold_cache_reads && o.plugin->evict_obj) || o.verbosity >= 2;
+
+  if ((o.cold_cache || o.cold_cache_reads) && ! o.plugin->evict_obj && ! o.plugin->evict_caches && o.rank == 0){
+    printf("WARNING: plugin %s does not support evicting the caches\n", o.plugin->name);
+  }
+  if (o.cold_cache_reads && (use_async_benchmark() || use_batch_benchmark()) && o.rank == 0){
+    printf("WARNING: the objects are not evicted before the reads with a queue depth or batches\n");
+  }
+
+  if (o.threads < 1){
+    if(o.rank == 0)
+      printf("Invalid options, the number of threads per rank must be at least 1\n");
+    exit(1);
+  }
+  if (o.threads > 1){
+    if (! o.plugin->thread_initialize || ! o.plugin->thread_finalize){
+      if(o.rank == 0)
+        printf("Invalid options, plugin %s does not support multiple threads per rank\n", o.plugin->name);
+      exit(1);
+    }
+    if (o.stonewall_timer_wear_out){
+      if(o.rank == 0)
+        printf("Invalid options, stonewall wear-out cannot be used with multiple threads per rank\n");
+      exit(1);
+    }
+    if (thread_support < MPI_THREAD_FUNNELED && o.rank == 0){
+      printf("WARNING: the MPI library does not support threads\n");
+    }
+    if (o.threads > o.dset_count && o.rank == 0){
+      printf("WARNING: more threads than data sets, some threads will be idle\n");
+    }
+  }
+
   ret = o.plugin->initialize();
   if (ret != MD_SUCCESS){
     printf("%d: Error initializing module\n", o.rank);
     MPI_Abort(MPI_COMM_WORLD, 1);
   }
+  if (o.threads > 1){
+    start_threads();
+  }
 
   int current_index = 0;
 
@@ -1018,7 +3034,7 @@ int main(int argc, char ** argv){
 
   size_t total_obj_count = o.dset_count * (size_t) (o.num * o.iterations + o.precreate) * o.size;
   if (o.rank == 0 && ! o.quiet_output){
-    printf("MD-Workbench total objects: %zu workingset size: %.3f MiB (version: %s) time: ", total_obj_count, ((double) o.size) * o.dset_count * o.precreate * o.file_size / 1024.0 / 1024.0,  VERSION);
+    printf("MD-Workbench total objects: %zu workingset size: %.3f MiB (version: %s) time: ", total_obj_count, ((double) o.size) * o.dset_count * o.precreate * mean_object_size() / 1024.0 / 1024.0,  VERSION);
     printTime();
     if(o.num > o.precreate){
       printf("WARNING: num > precreate, this may cause the situation that no objects are available to read\n");
@@ -1064,7 +3080,7 @@ int main(int argc, char ** argv){
 
     // pre-creation phase
     start_timer(& phase_stats.phase_start_timer);
-    run_precreate(& phase_stats, current_index);
+    run_phase(PHASE_PRECREATE, & phase_stats, & current_index);
     phase_stats.t = stop_timer(phase_stats.phase_start_timer);
     end_phase("precreate", & phase_stats);
   }
@@ -1075,19 +3091,28 @@ int main(int argc, char ** argv){
       if(o.adaptive_waiting_mode){
         o.relative_waiting_factor = 0;
       }
+      if(o.shuffle_ranks){
+        shuffle_ranks();
+      }
+      if(o.cold_cache){
+        evict_phase(PHASE_BENCHMARK, current_index);
+      }
       init_stats(& phase_stats, o.num * o.dset_count);
       MPI_Barrier(MPI_COMM_WORLD);
       start_timer(& phase_stats.phase_start_timer);
-      run_benchmark(& phase_stats, & current_index);
+      run_phase(PHASE_BENCHMARK, & phase_stats, & current_index);
       end_phase("benchmark", & phase_stats);
 
       if(o.adaptive_waiting_mode){
         o.relative_waiting_factor = 0.0625;
         for(int r=0; r <= 6; r++){
+          if(o.cold_cache){
+            evict_phase(PHASE_BENCHMARK, current_index);
+          }
           init_stats(& phase_stats, o.num * o.dset_count);
           MPI_Barrier(MPI_COMM_WORLD);
           start_timer(& phase_stats.phase_start_timer);
-          run_benchmark(& phase_stats, & current_index);
+          run_phase(PHASE_BENCHMARK, & phase_stats, & current_index);
           end_phase("benchmark", & phase_stats);
           o.relative_waiting_factor *= 2;
         }
@@ -1097,9 +3122,12 @@ int main(int argc, char ** argv){
 
   // cleanup phase
   if (o.phase_cleanup){
+    if(o.cold_cache){
+      evict_phase(PHASE_CLEANUP, current_index);
+    }
     init_stats(& phase_stats, o.precreate * o.dset_count);
     start_timer(& phase_stats.phase_start_timer);
-    run_cleanup(& phase_stats, current_index);
+    run_phase(PHASE_CLEANUP, & phase_stats, & current_index);
     phase_stats.t = stop_timer(phase_stats.phase_start_timer);
     end_phase("cleanup", & phase_stats);
 
@@ -1114,6 +3142,9 @@ int main(int argc, char ** argv){
   }
 
   double t_all = stop_timer(bench_start);
+  if (o.threads > 1){
+    stop_threads();
+  }
   ret = o.plugin->finalize();
   if (ret != MD_SUCCESS){
     printf("Error while finalization of module\n");
@@ -1125,6 +3156,20 @@ int main(int argc, char ** argv){
 
   mem_free_preallocated(& limit_memory_P);
 
+  if(leader_comm != MPI_COMM_NULL){
+    MPI_Comm_free(& leader_comm);
+  }
+  MPI_Comm_free(& node_comm);
+  MPI_Comm_free(& interval_comm);
+  free(rank_perm);
+  free(rank_perm_inv);
+  free(zipf_sums);
+  MPI_Type_free(& interval_type);
+  MPI_Op_free(& interval_op);
+  free(interval_pending);
+  MPI_Type_free(& time_result_type);
+  MPI_Op_free(& histogram_op);
+  MPI_Type_free(& histogram_type);
   MPI_Finalize();
   return 0;
 }
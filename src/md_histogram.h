@@ -0,0 +1,46 @@
+// This file is part of MD-REAL-IO.
+//
+// MD-REAL-IO is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// MD-REAL-IO is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with MD-REAL-IO.  If not, see <http://www.gnu.org/licenses/>.
+//
+// Author: Julian Kunkel
+
+#ifndef MD_HISTOGRAM_H
+#define MD_HISTOGRAM_H
+
+#include <stdint.h>
+
+// A log-linear (HDR) histogram for runtimes given in seconds.
+// Values are bucketed in ns, below 2^HISTOGRAM_SUB_BUCKET_BITS ns they are exact,
+// above, each power of two is split into 2^HISTOGRAM_SUB_BUCKET_BITS buckets, i.e., the relative error is below 1%.
+#define HISTOGRAM_SUB_BUCKET_BITS 7
+// values larger than 2^HISTOGRAM_MAX_EXPONENT ns (about 73 minutes) are accounted in the last bucket
+#define HISTOGRAM_MAX_EXPONENT 42
+#define HISTOGRAM_BUCKETS ((HISTOGRAM_MAX_EXPONENT - HISTOGRAM_SUB_BUCKET_BITS + 1) << HISTOGRAM_SUB_BUCKET_BITS)
+
+typedef struct{
+  uint64_t count;
+  // the exact extreme values
+  double min;
+  double max;
+  uint64_t buckets[HISTOGRAM_BUCKETS];
+} histogram_t;
+
+void histogram_init(histogram_t * h);
+void histogram_add(histogram_t * h, double value);
+// add the values of other to h
+void histogram_merge(histogram_t * h, const histogram_t * other);
+// returns the value at the quantile (0 to 1), 0 if the histogram is empty
+double histogram_quantile(const histogram_t * h, double quantile);
+
+#endif
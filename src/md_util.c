@@ -22,6 +22,7 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
+#include <math.h>
 #include <unistd.h>
 
 #include <md_util.h>
@@ -78,3 +79,332 @@ double stop_timer(timer t1) {
 }
 
 #endif
+
+uint32_t string_hash(const char * str){
+  uint32_t hash = 2166136261u;
+  for(const char * c = str; *c != 0; c++){
+    hash = (hash ^ (unsigned char) *c) * 16777619u;
+  }
+  return hash;
+}
+
+static cache_entry_t ** cache_bucket(cache_t * c, const char * key){
+  if(c->buckets == NULL){
+    c->buckets = calloc(CACHE_BUCKETS, sizeof(cache_entry_t *));
+  }
+  return & c->buckets[string_hash(key) % CACHE_BUCKETS];
+}
+
+cache_entry_t * cache_find(cache_t * c, const char * key){
+  if(c->buckets == NULL){
+    return NULL;
+  }
+  for(cache_entry_t * e = *cache_bucket(c, key); e != NULL; e = e->next){
+    if(strcmp(e->key, key) == 0){
+      return e;
+    }
+  }
+  return NULL;
+}
+
+cache_entry_t * cache_insert(cache_t * c, const char * key, void * value){
+  cache_entry_t ** bucket = cache_bucket(c, key);
+  cache_entry_t * e = malloc(sizeof(cache_entry_t) + strlen(key) + 1);
+  strcpy(e->key, key);
+  e->value = value;
+  e->next = *bucket;
+  *bucket = e;
+  return e;
+}
+
+void * cache_remove(cache_t * c, const char * key){
+  if(c->buckets == NULL){
+    return NULL;
+  }
+  for(cache_entry_t ** e = cache_bucket(c, key); *e != NULL; e = & (*e)->next){
+    if(strcmp((*e)->key, key) == 0){
+      cache_entry_t * found = *e;
+      void * value = found->value;
+      *e = found->next;
+      free(found);
+      return value;
+    }
+  }
+  return NULL;
+}
+
+void cache_free(cache_t * c, void (*free_value)(void * value)){
+  if(c->buckets == NULL){
+    return;
+  }
+  for(int i=0; i < CACHE_BUCKETS; i++){
+    while(c->buckets[i] != NULL){
+      cache_entry_t * e = c->buckets[i];
+      c->buckets[i] = e->next;
+      if(free_value){
+        free_value(e->value);
+      }
+      free(e);
+    }
+  }
+  free(c->buckets);
+  c->buckets = NULL;
+}
+
+char * format_int(char * out, int value){
+  char digits[12];
+  int count = 0;
+  unsigned int v = value < 0 ? - (unsigned int) value : (unsigned int) value;
+  if(value < 0){
+    *out++ = '-';
+  }
+  do{
+    digits[count++] = (char) ('0' + v % 10);
+    v /= 10;
+  }while(v > 0);
+  while(count > 0){
+    *out++ = digits[--count];
+  }
+  *out = 0;
+  return out;
+}
+
+char * format_str(char * out, const char * str){
+  while(*str != 0){
+    *out++ = *str++;
+  }
+  *out = 0;
+  return out;
+}
+
+static inline uint64_t pattern_word(uint64_t seed, uint64_t pos){
+  uint64_t w = (seed + pos) * 0x9E3779B97F4A7C15llu;
+  return w ^ (w >> 29);
+}
+
+void pattern_fill(char * buf, size_t size, uint64_t seed){
+  const size_t words = size / sizeof(uint64_t);
+  for(size_t i=0; i < words; i++){
+    uint64_t w = pattern_word(seed, i);
+    memcpy(buf + i * sizeof(uint64_t), & w, sizeof(uint64_t));
+  }
+  uint64_t w = pattern_word(seed, words);
+  memcpy(buf + words * sizeof(uint64_t), & w, size % sizeof(uint64_t));
+}
+
+int pattern_check(const char * buf, size_t size, uint64_t seed){
+  const size_t words = size / sizeof(uint64_t);
+  // the differences are accumulated without branches
+  uint64_t diff = 0;
+  for(size_t i=0; i < words; i++){
+    uint64_t w;
+    memcpy(& w, buf + i * sizeof(uint64_t), sizeof(uint64_t));
+    diff |= w ^ pattern_word(seed, i);
+  }
+  uint64_t w = pattern_word(seed, words);
+  return diff != 0 || memcmp(buf + words * sizeof(uint64_t), & w, size % sizeof(uint64_t)) != 0;
+}
+
+// the seed of the blocks that are shared by all objects with PAYLOAD_DEDUP
+#define PAYLOAD_DEDUP_SEED 0x5DEECE66Dllu
+
+int payload_parse(payload_t * p, const char * str){
+  memset(p, 0, sizeof(payload_t));
+  if(strcmp(str, "zero") == 0){
+    p->type = PAYLOAD_ZERO;
+    return 0;
+  }
+  if(strcmp(str, "random") == 0){
+    p->type = PAYLOAD_RANDOM;
+    return 0;
+  }
+  if(strncmp(str, "compressible:", 13) == 0){
+    p->type = PAYLOAD_COMPRESSIBLE;
+    p->ratio = atof(str + 13);
+    return p->ratio >= 1 ? 0 : 1;
+  }
+  if(strncmp(str, "dedup:", 6) == 0){
+    p->type = PAYLOAD_DEDUP;
+    p->percent = atoi(str + 6);
+    return p->percent >= 0 && p->percent <= 100 ? 0 : 1;
+  }
+  return 1;
+}
+
+// the block with the index block of the object, the random words are numbered consecutively across the blocks
+static void payload_fill_block(const payload_t * p, char * buf, size_t size, uint64_t seed, uint64_t block){
+  const uint64_t first_word = block * (PAYLOAD_BLOCK / sizeof(uint64_t));
+  switch(p->type){
+    case(PAYLOAD_ZERO):
+      memset(buf, 0, size);
+      return;
+    case(PAYLOAD_COMPRESSIBLE):{
+      size_t random = (size_t) (PAYLOAD_BLOCK / p->ratio) / sizeof(uint64_t) * sizeof(uint64_t);
+      random = random < size ? random : size;
+      pattern_fill(buf, random, seed + first_word);
+      memset(buf + random, 0, size - random);
+      return;
+    }
+    case(PAYLOAD_DEDUP):
+      if(pattern_word(seed, ~block) % 100 < (uint64_t) p->percent){
+        pattern_fill(buf, size, PAYLOAD_DEDUP_SEED);
+        return;
+      }
+      pattern_fill(buf, size, seed + first_word);
+      return;
+    default:
+      pattern_fill(buf, size, seed + first_word);
+  }
+}
+
+void payload_fill(const payload_t * p, char * buf, size_t size, uint64_t seed){
+  if(p->type == PAYLOAD_RANDOM){
+    pattern_fill(buf, size, seed);
+    return;
+  }
+  for(size_t off = 0; off < size; off += PAYLOAD_BLOCK){
+    size_t len = size - off < PAYLOAD_BLOCK ? size - off : PAYLOAD_BLOCK;
+    payload_fill_block(p, buf + off, len, seed, off / PAYLOAD_BLOCK);
+  }
+}
+
+int payload_check(const payload_t * p, const char * buf, size_t size, uint64_t seed){
+  if(p->type == PAYLOAD_RANDOM){
+    return pattern_check(buf, size, seed);
+  }
+  char expected[PAYLOAD_BLOCK];
+  for(size_t off = 0; off < size; off += PAYLOAD_BLOCK){
+    size_t len = size - off < PAYLOAD_BLOCK ? size - off : PAYLOAD_BLOCK;
+    payload_fill_block(p, expected, len, seed, off / PAYLOAD_BLOCK);
+    if(memcmp(buf + off, expected, len) != 0){
+      return 1;
+    }
+  }
+  return 0;
+}
+
+double payload_physical_fraction(const payload_t * p){
+  switch(p->type){
+    case(PAYLOAD_ZERO):
+      return 0;
+    case(PAYLOAD_COMPRESSIBLE):
+      return 1 / p->ratio;
+    case(PAYLOAD_DEDUP):
+      return (100 - p->percent) / 100.0;
+    default:
+      return 1;
+  }
+}
+
+// the position of the pattern word used to draw the size of an object, it does not overlap with the words of its payload
+#define SIZE_DIST_POS (1llu << 62)
+#define SIZE_DIST_SAMPLES 65536
+
+// a uniform number in [0, 1) for the object
+static double size_dist_uniform(uint64_t seed, uint64_t pos){
+  return (pattern_word(seed, SIZE_DIST_POS + pos) >> 11) * (1.0 / (1llu << 53));
+}
+
+static int size_dist_load(size_dist_t * d, const char * file){
+  FILE * f = fopen(file, "r");
+  if(f == NULL){
+    return 1;
+  }
+  char line[1024];
+  int size = 0;
+  int ret = 0;
+  d->count = 0;
+  while(fgets(line, sizeof(line), f) != NULL){
+    unsigned long long obj_size;
+    double fraction;
+    char * start = line + strspn(line, " \t");
+    if(*start == '#' || *start == '\n' || *start == 0){
+      continue;
+    }
+    if(sscanf(start, "%llu %lf", & obj_size, & fraction) != 2 || (d->count > 0 && (fraction < d->cdf[d->count - 1] || obj_size < d->sizes[d->count - 1]))){
+      ret = 1;
+      break;
+    }
+    if(d->count == size){
+      size = size * 2 + 16;
+      d->sizes = (size_t *) realloc(d->sizes, sizeof(size_t) * size);
+      d->cdf = (double *) realloc(d->cdf, sizeof(double) * size);
+    }
+    d->sizes[d->count] = (size_t) obj_size;
+    d->cdf[d->count] = fraction;
+    d->count++;
+  }
+  fclose(f);
+  if(ret != 0 || d->count == 0 || d->cdf[d->count - 1] <= 0){
+    return 1;
+  }
+  // the fractions may be given in percent or as counts
+  const double total = d->cdf[d->count - 1];
+  for(int i=0; i < d->count; i++){
+    d->cdf[i] /= total;
+  }
+  d->min = d->sizes[0];
+  d->max = d->sizes[d->count - 1];
+  return 0;
+}
+
+int size_dist_parse(size_dist_t * d, const char * str, size_t max_size){
+  memset(d, 0, sizeof(size_dist_t));
+  int ret = 1;
+  if(strncmp(str, "uniform:", 8) == 0){
+    unsigned long long min, max;
+    d->type = SIZE_UNIFORM;
+    if(sscanf(str + 8, "%llu:%llu", & min, & max) == 2 && min <= max){
+      d->min = (size_t) min;
+      d->max = (size_t) max;
+      ret = 0;
+    }
+  }else if(strncmp(str, "lognormal:", 10) == 0){
+    double median;
+    d->type = SIZE_LOGNORMAL;
+    if(sscanf(str + 10, "%lf:%lf", & median, & d->sigma) == 2 && median > 0 && d->sigma >= 0){
+      d->mu = log(median);
+      d->max = max_size;
+      ret = 0;
+    }
+  }else if(strncmp(str, "cdf:", 4) == 0){
+    d->type = SIZE_CDF;
+    ret = size_dist_load(d, str + 4);
+  }
+  if(ret != 0){
+    return ret;
+  }
+  double sum = 0;
+  for(uint64_t i=0; i < SIZE_DIST_SAMPLES; i++){
+    sum += size_dist_sample(d, i * 0x9E3779B97F4A7C15llu);
+  }
+  d->mean = sum / SIZE_DIST_SAMPLES;
+  return 0;
+}
+
+size_t size_dist_sample(const size_dist_t * d, uint64_t seed){
+  const double u = size_dist_uniform(seed, 0);
+  switch(d->type){
+    case(SIZE_UNIFORM):
+      return d->min + (size_t) (u * (d->max - d->min + 1));
+    case(SIZE_LOGNORMAL):{
+      // Box-Muller transform of two uniform numbers
+      const double z = sqrt(-2 * log(1 - u)) * cos(2 * M_PI * size_dist_uniform(seed, 1));
+      const double size = exp(d->mu + d->sigma * z) + 0.5;
+      return size >= d->max ? d->max : (size_t) size;
+    }default:{
+      // the first entry with a cumulative fraction above u
+      int first = 0;
+      int last = d->count - 1;
+      while(first < last){
+        int mid = (first + last) / 2;
+        if(d->cdf[mid] > u){
+          last = mid;
+        }else{
+          first = mid + 1;
+        }
+      }
+      return d->sizes[first];
+    }
+  }
+}
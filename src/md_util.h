@@ -19,6 +19,7 @@
 #define MD_UTIL_H
 
 #include <stdint.h>
+#include <stddef.h>
 #include <time.h>
 
 // timer functions
@@ -32,9 +33,104 @@ void start_timer(timer * t1);
 double stop_timer(timer t1);
 double timer_subtract(timer number, timer subtract);
 
+// FNV-1a hash of a string, e.g., for caches of the plugins
+uint32_t string_hash(const char * str);
+
+// a cache of values keyed by a string with chained buckets, e.g., the handles of the data sets of a plugin
+// a zero-initialized cache_t is empty, the buckets are allocated with the first insert
+#define CACHE_BUCKETS 1024
+
+typedef struct cache_entry_t{
+  struct cache_entry_t * next;
+  void * value;
+  char key[];
+} cache_entry_t;
+
+typedef struct{
+  cache_entry_t ** buckets;
+} cache_t;
+
+// returns the entry of the key or NULL
+cache_entry_t * cache_find(cache_t * c, const char * key);
+// adds the key, which must not be contained, the key of the entry remains valid until it is removed
+cache_entry_t * cache_insert(cache_t * c, const char * key, void * value);
+// removes the key and returns its value, NULL if it is not contained
+void * cache_remove(cache_t * c, const char * key);
+// removes all entries, free_value is called for their values unless it is NULL
+void cache_free(cache_t * c, void (*free_value)(void * value));
+
+// fast formatting of names without sprintf, e.g., for def_obj_name
+// the text is written to out followed by a terminating 0, the position of the 0 is returned to append further text
+char * format_int(char * out, int value);
+char * format_str(char * out, const char * str);
+
+// a deterministic data pattern derived from the seed, e.g., to verify the data of the objects
+// each 64 bit word is computed from its position only, thus the compiler can vectorize the loops
+void pattern_fill(char * buf, size_t size, uint64_t seed);
+// returns 0 if the buffer contains the pattern
+int pattern_check(const char * buf, size_t size, uint64_t seed);
+
+// the content of the objects with a given compressibility or share of duplicated blocks
+// the payload is generated in blocks of PAYLOAD_BLOCK bytes, the random data of each object is unique
+#define PAYLOAD_BLOCK 4096
+
+typedef enum{
+  PAYLOAD_ZERO,
+  PAYLOAD_RANDOM,
+  PAYLOAD_COMPRESSIBLE, // the first 1/ratio of each block is random, the rest zero
+  PAYLOAD_DEDUP // percent of the blocks are identical across all objects, the others random
+} payload_type_t;
+
+typedef struct{
+  payload_type_t type;
+  double ratio;
+  int percent;
+} payload_t;
+
+// parse zero, random, compressible:RATIO or dedup:PERCENT, returns 0 on success
+int payload_parse(payload_t * p, const char * str);
+void payload_fill(const payload_t * p, char * buf, size_t size, uint64_t seed);
+// returns 0 if the buffer contains the payload
+int payload_check(const payload_t * p, const char * buf, size_t size, uint64_t seed);
+// the expected share of the data that remains after compression and deduplication
+double payload_physical_fraction(const payload_t * p);
+
+// the distribution of the object sizes, the size of an object is derived from a seed, i.e., it is deterministic per object
+typedef enum{
+  SIZE_UNIFORM,
+  SIZE_LOGNORMAL, // truncated at max
+  SIZE_CDF // an empirical distribution
+} size_dist_type_t;
+
+typedef struct{
+  size_dist_type_t type;
+  size_t min;
+  size_t max; // the largest size of the distribution
+  double mu;
+  double sigma;
+  double mean; // estimated from a sample
+  // the entries of the empirical distribution with the cumulative fraction of the sizes
+  int count;
+  size_t * sizes;
+  double * cdf;
+} size_dist_t;
+
+// parse uniform:MIN:MAX, lognormal:MEDIAN:SIGMA or cdf:FILE, max_size limits the lognormal distribution, returns 0 on success
+// the file of the empirical distribution contains lines with a size and the cumulative fraction of the objects up to this size, # starts a comment
+int size_dist_parse(size_dist_t * d, const char * str, size_t max_size);
+size_t size_dist_sample(const size_dist_t * d, uint64_t seed);
+
 
 // allow to allocate memory
 int mem_preallocate(char ** allocP, uint64_t maxRAMinMB, int verbose);
 void mem_free_preallocated(char ** allocP);
 
+// the I/O buffers are aligned and padded to this size, e.g., for O_DIRECT
+#define MEM_ALIGNMENT 4096
+#define MEM_PADDED_SIZE(size) (((size) + MEM_ALIGNMENT - 1) / MEM_ALIGNMENT * MEM_ALIGNMENT)
+
+// allocate an aligned buffer padded to MEM_ALIGNMENT, with hugepages it is backed by huge pages if possible
+char * mem_alloc_aligned(size_t size, int hugepages);
+void mem_free_aligned(char * buf, size_t size, int hugepages);
+
 #endif
@@ -17,6 +17,7 @@
 
 #include <sys/types.h>
 #include <sys/stat.h>
+#include <sys/mman.h>
 #include <fcntl.h>
 
 #include <stdint.h>
@@ -113,3 +114,42 @@ void mem_free_preallocated(char ** allocP){
   free(*allocP);
   *allocP = NULL;
 }
+
+#define HUGEPAGE_SIZE (2 * 1024 * 1024)
+
+static size_t hugepage_size(size_t size){
+  return (size + HUGEPAGE_SIZE - 1) / HUGEPAGE_SIZE * HUGEPAGE_SIZE;
+}
+
+char * mem_alloc_aligned(size_t size, int hugepages){
+  if(! hugepages){
+    void * buf;
+    if(posix_memalign(& buf, MEM_ALIGNMENT, MEM_PADDED_SIZE(size)) != 0){
+      return NULL;
+    }
+    return (char *) buf;
+  }
+  size_t len = hugepage_size(size);
+  char * buf = mmap(NULL, len, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+  if(buf != MAP_FAILED){
+    return buf;
+  }
+  // no huge pages are reserved, try transparent huge pages instead
+  buf = mmap(NULL, len, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if(buf == MAP_FAILED){
+    return NULL;
+  }
+  madvise(buf, len, MADV_HUGEPAGE);
+  return buf;
+}
+
+void mem_free_aligned(char * buf, size_t size, int hugepages){
+  if(buf == NULL){
+    return;
+  }
+  if(! hugepages){
+    free(buf);
+    return;
+  }
+  munmap(buf, hugepage_size(size));
+}